@@ -20,6 +20,9 @@
 
 #include <CLI/CLI.hpp>
 
+#include <chrono>
+#include <sstream>
+
 namespace fs = std::filesystem;
 namespace mc = mediacopier;
 
@@ -41,27 +44,64 @@ std::pair<mc::Cli::ParseResult, int> mc::Cli::parseArgs(int argc, char** argv)
 
     const auto& setUseUtc = [this](size_t /* count */) -> void { m_useUtc = true; };
 
+    const auto& setSince = [this](const std::string& date) -> void {
+        std::istringstream is { date };
+        std::chrono::local_days day;
+        is >> std::chrono::parse("%F", day);
+        if (is.fail()) {
+            throw CLI::ValidationError { "Invalid date, expected YYYY-MM-DD: " + date };
+        }
+        m_since = std::chrono::current_zone()->to_sys(day);
+    };
+
+    const auto& addOptions = [&](CLI::App* subapp) -> void {
+        subapp->add_option("inputDir", m_inputDir)->required()->check(CLI::ExistingDirectory);
+        subapp->add_option("outputDir", m_outputDir)->required()->check(isValidPath, "DIR");
+        subapp->add_option("-p,--pattern", m_pattern, "Pattern to be used for constructing filenames");
+        subapp->add_flag("-u,--utc", setUseUtc, "Use UTC timestamps when constructing filenames");
+        subapp->add_option("--prefetch-depth", m_prefetchDepth, "Number of files to read ahead while probing metadata")->check(CLI::PositiveNumber);
+        subapp->add_option("--probe-threads", m_probeThreads, "Number of threads reading metadata (default: one per core)")->check(CLI::PositiveNumber);
+        subapp->add_flag("-i,--incremental", m_incremental, "Skip files that were handled by a previous run and didn't change since");
+        subapp->add_option_function<std::string>("--since", setSince, "Skip files last modified before this date (YYYY-MM-DD)");
+        subapp->add_option("--compare-bytes", m_compareBudget, "Number of bytes compared when two files have the same hash (default: 8192, 0 trusts the hash)");
+    };
+
+    const auto& addVerifyOptions = [this](CLI::App* subapp) -> void {
+        subapp->add_flag("--verify", m_verify, "Read every copy back from the disk and compare it with the original");
+        subapp->add_flag("--manifest", m_manifest, "Write the checksums of the imported files to SHA256SUMS in the output directory (implies --verify)");
+    };
+
     auto copyapp = app.add_subcommand("copy", "Copy some files");
     copyapp->callback([this]() { m_command = Command::Copy; });
-    copyapp->add_option("inputDir", m_inputDir)->required()->check(CLI::ExistingDirectory);
-    copyapp->add_option("outputDir", m_outputDir)->required()->check(isValidPath, "DIR");
-    copyapp->add_option("-p,--pattern", m_pattern, "Pattern to be used for constructing filenames");
-    copyapp->add_flag("-u,--utc", setUseUtc, "Use UTC timestamps when constructing filenames");
+    addOptions(copyapp);
+    addVerifyOptions(copyapp);
+    copyapp->add_option("--copy-depth", m_copyDepth, "Number of files being copied at the same time")->check(CLI::PositiveNumber);
 
     auto moveapp = app.add_subcommand("move", "Move some files");
     moveapp->callback([this]() { m_command = Command::Move; });
-    moveapp->add_option("inputDir", m_inputDir)->required()->check(CLI::ExistingDirectory);
-    moveapp->add_option("outputDir", m_outputDir)->required()->check(isValidPath, "DIR");
-    moveapp->add_option("-p,--pattern", m_pattern, "Pattern to be used for constructing filenames");
-    moveapp->add_flag("-u,--utc", setUseUtc, "Use UTC timestamps when constructing filenames");
+    addOptions(moveapp);
+    addVerifyOptions(moveapp);
+
+    auto linkapp = app.add_subcommand("link", "Hard link some files, they are copied if that is not possible");
+    linkapp->callback([this]() { m_command = Command::Link; });
+    addOptions(linkapp);
+
+#ifdef __linux__
+    auto watchapp = app.add_subcommand("watch", "Keep running and import new files as soon as they are written");
+    watchapp->callback([this]() { m_command = Command::Watch; });
+    addOptions(watchapp);
+    addVerifyOptions(watchapp);
+    auto watchMove = watchapp->add_flag("-m,--move", m_watchMove, "Move files instead of copying them");
+    watchapp->add_flag("-l,--link", m_watchLink, "Hard link files instead of copying them")->excludes(watchMove);
+    watchapp->add_option_function<unsigned>(
+        "--quiet-period", [this](unsigned ms) { m_quietPeriod = std::chrono::milliseconds { ms }; },
+        "Time in ms a file must remain untouched before it is imported");
+#endif
 
 #ifndef NDEBUG
     auto simapp = app.add_subcommand("sim", "Simulate operation and dump info");
     simapp->callback([this]() { m_command = Command::Sim; });
-    simapp->add_option("inputDir", m_inputDir)->required()->check(CLI::ExistingDirectory);
-    simapp->add_option("outputDir", m_outputDir)->required()->check(isValidPath, "DIR");
-    simapp->add_option("-p,--pattern", m_pattern, "Pattern to be used for constructing filenames");
-    simapp->add_flag("-u,--utc", setUseUtc, "Use UTC timestamps when constructing filenames");
+    addOptions(simapp);
 #endif
 
     int ret = 0;
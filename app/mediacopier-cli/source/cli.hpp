@@ -16,8 +16,15 @@
 
 #pragma once
 
+#include <mediacopier/copy_executor.hpp>
+#include <mediacopier/directory_watcher.hpp>
+#include <mediacopier/duplicate_check.hpp>
+#include <mediacopier/header_prefetcher.hpp>
 #include <mediacopier/persistent_config.hpp>
 
+#include <chrono>
+#include <optional>
+
 namespace mediacopier {
 
 class Cli : public PersistentConfig {
@@ -25,7 +32,11 @@ public:
     enum class Command {
         Copy,
         Move,
+        Link,
         Sim,
+#ifdef __linux__
+        Watch,
+#endif
     };
     enum class ParseResult {
         Continue,
@@ -37,11 +48,37 @@ public:
     auto outputDir() const -> const std::filesystem::path& { return m_outputDir; }
     auto pattern() const -> const std::string& { return m_pattern.get(); }
     auto useUtc() const -> bool { return m_useUtc; }
+    auto prefetchDepth() const -> size_t { return m_prefetchDepth; }
+    auto probeThreads() const -> size_t { return m_probeThreads; }
+    auto copyDepth() const -> size_t { return m_copyDepth; }
+    auto incremental() const -> bool { return m_incremental; }
+    auto compareBudget() const -> uint64_t { return m_compareBudget; }
+    auto verify() const -> bool { return m_verify || m_manifest; }
+    auto manifest() const -> bool { return m_manifest; }
+#ifdef __linux__
+    auto watchMove() const -> bool { return m_watchMove; }
+    auto watchLink() const -> bool { return m_watchLink; }
+    auto quietPeriod() const -> std::chrono::milliseconds { return m_quietPeriod; }
+#endif
+    auto since() const -> const std::optional<std::chrono::system_clock::time_point>& { return m_since; }
 
 private:
     Command m_command = Command::Copy;
     std::filesystem::path m_inputDir;
     std::filesystem::path m_outputDir;
+    size_t m_prefetchDepth = HeaderPrefetcher::DEFAULT_DEPTH;
+    size_t m_probeThreads = 0;
+    size_t m_copyDepth = CopyExecutor::DEFAULT_DEPTH;
+    bool m_incremental = false;
+    uint64_t m_compareBudget = DEFAULT_COMPARE_BUDGET;
+    bool m_verify = false;
+    bool m_manifest = false;
+    std::optional<std::chrono::system_clock::time_point> m_since;
+#ifdef __linux__
+    bool m_watchMove = false;
+    bool m_watchLink = false;
+    std::chrono::milliseconds m_quietPeriod = DirectoryWatcher::DEFAULT_QUIET_PERIOD;
+#endif
 };
 
 } // namespace mediacopier
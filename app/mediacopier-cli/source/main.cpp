@@ -14,9 +14,17 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include <mediacopier/file_info_factory.hpp>
+#include <mediacopier/copy_engine.hpp>
+#include <mediacopier/copy_executor.hpp>
+#include <mediacopier/copy_verifier.hpp>
+#include <mediacopier/directory_walker.hpp>
+#include <mediacopier/directory_watcher.hpp>
 #include <mediacopier/file_register.hpp>
+#include <mediacopier/header_prefetcher.hpp>
+#include <mediacopier/import_catalog.hpp>
+#include <mediacopier/metadata_prober.hpp>
 #include <mediacopier/operation_copy_jpeg.hpp>
+#include <mediacopier/operation_link_jpeg.hpp>
 #include <mediacopier/operation_move_jpeg.hpp>
 #include <mediacopier/operation_simulate.hpp>
 
@@ -24,29 +32,129 @@
 
 #include <atomic>
 #include <csignal>
-#include <ranges>
+#include <type_traits>
+#include <unordered_map>
 
 #include "cli.hpp"
 
 namespace fs = std::filesystem;
 namespace mc = mediacopier;
 
+using Outcome = mc::ImportCatalog::Outcome;
+
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
 static volatile std::atomic<bool> operationCancelled(false);
 
-auto media_files(const fs::path& path)
+// rotated jpeg files are transformed while copying, all others can be handed to the copy executor
+static auto is_plain_copy(const mc::FileInfo& info) -> bool
 {
-    static auto convert = [](const fs::directory_entry& entry) -> mc::FileInfoPtr {
-        if (fs::is_regular_file(entry)) {
-            return mc::to_file_info_ptr(entry.path());
-        } else {
-            return nullptr;
+    const auto* jpeg = std::get_if<mc::FileInfoImageJpeg>(&info);
+    return jpeg == nullptr || jpeg->orientation() == mc::FileInfoImageJpeg::Orientation::ROT_0;
+}
+
+// only copy and move operations can be verified
+template <typename Operation>
+auto execute(const fs::path& dest, const mc::FileInfo& info, mc::CopyVerifier* verifier) -> void
+{
+    if constexpr (std::is_constructible_v<Operation, fs::path, mc::CopyVerifier*>) {
+        mc::execute_operation<Operation>(dest, info, verifier);
+    } else {
+        mc::execute_operation<Operation>(dest, info);
+    }
+}
+
+// returns no outcome if the copy was submitted to the executor, it is reported on completion then
+template <typename Operation>
+auto process(mc::FileRegister& fileRegister, const mc::MetadataProber::Entry& probed, std::optional<fs::path>& dest,
+    mc::CopyVerifier* verifier, mc::CopyExecutor* executor = nullptr, uint64_t tag = 0) -> std::optional<Outcome>
+{
+    try {
+        if (probed.error != nullptr) {
+            std::rethrow_exception(probed.error);
+        }
+        if (!probed.info.has_value()) {
+            return Outcome::NotMedia;
+        }
+        const auto& file = mc::file_info_base(probed.info.value());
+        if (!(dest = fileRegister.add(file)).has_value()) {
+            return Outcome::Duplicate;
+        }
+        spdlog::info("Processing: {0} -> {1}", file.path().string(), dest.value().string());
+        if (executor != nullptr && is_plain_copy(probed.info.value())) {
+            fileRegister.setPending(dest.value());
+            executor->submit({ file.path(), dest.value(), tag });
+            return {};
+        }
+        execute<Operation>(dest.value(), probed.info.value(), verifier);
+        return Outcome::Imported;
+    } catch (const std::exception& err) {
+        spdlog::error(err.what());
+    }
+    return Outcome::Error;
+}
+
+template <typename Operation>
+auto import_files(const mc::Cli& cli, mc::FileRegister& fileRegister, std::optional<mc::ImportCatalog>& catalog, mc::CopyVerifier* verifier) -> void
+{
+    const auto& since = cli.since();
+
+    // file status is only needed for skipping files, otherwise the walker gets away without stat
+    auto walker = mc::DirectoryWalker { cli.inputDir(), catalog.has_value() || since.has_value() };
+    auto prefetcher = mc::HeaderPrefetcher { walker, cli.prefetchDepth() };
+    prefetcher.setFilter([&catalog, &since](const mc::DirectoryWalker::Entry& entry) -> bool {
+        if (since.has_value() && entry.modified < since.value()) {
+            return false;
+        }
+        return !catalog.has_value() || !catalog->isUnchanged(entry);
+    });
+    auto prober = mc::MetadataProber { prefetcher, cli.probeThreads() };
+    std::optional<fs::path> dest;
+
+    // plain copies run in the background, several files at once
+    auto executor = std::optional<mc::CopyExecutor> {};
+    if constexpr (std::is_same_v<Operation, mc::FileOperationCopyJpeg>) {
+        executor.emplace(cli.copyDepth(), mc::DeviceLimits {}, verifier);
+    }
+    std::unordered_map<uint64_t, mc::DirectoryWalker::Entry> copying;
+    uint64_t tag = 0;
+
+    const auto& completed = [&fileRegister, &catalog, &copying](std::vector<mc::CopyExecutor::Completion> completions) -> void {
+        for (const auto& completion : completions) {
+            fileRegister.setFinished(completion.job.destination);
+            auto outcome = Outcome::Imported;
+            if (completion.error != nullptr) {
+                try {
+                    std::rethrow_exception(completion.error);
+                } catch (const std::exception& err) {
+                    spdlog::error(err.what());
+                }
+                outcome = Outcome::Error;
+            }
+            auto entry = copying.extract(completion.job.tag);
+            if (catalog.has_value()) {
+                catalog->record(entry.mapped(), outcome, outcome == Outcome::Imported ? completion.job.destination : fs::path {});
+            }
         }
     };
-    return std::ranges::subrange(
-               fs::recursive_directory_iterator(path),
-               fs::recursive_directory_iterator())
-        | std::ranges::views::transform(convert);
+
+    for (const auto& probed : prober) {
+        if (operationCancelled.load()) {
+            spdlog::warn("Operation was cancelled..");
+            break;
+        }
+        const auto outcome = process<Operation>(fileRegister, probed, dest, verifier, executor.has_value() ? &executor.value() : nullptr, tag);
+        if (!outcome.has_value()) {
+            copying.emplace(tag++, probed.file);
+        } else if (catalog.has_value()) {
+            catalog->record(probed.file, outcome.value(), outcome == Outcome::Imported ? dest.value() : fs::path {});
+        }
+        if (executor.has_value()) {
+            completed(executor->poll());
+        }
+    }
+    if (executor.has_value()) {
+        completed(executor->drain());
+    }
 }
 
 template <typename Operation>
@@ -57,31 +165,114 @@ auto exec(const mc::Cli& cli) -> void
         operationCancelled.store(true);
     });
 
-    auto fileRegister = mc::FileRegister { cli.outputDir(), cli.pattern(), cli.useUtc() };
+    constexpr bool simulate = std::is_same_v<Operation, mc::FileOperationSimulate>;
+
+    auto fileRegister = mc::FileRegister { cli.outputDir(), cli.pattern(), cli.useUtc(), cli.compareBudget() };
+    auto catalog = std::optional<mc::ImportCatalog> {};
+    if (cli.incremental()) {
+        catalog.emplace(cli.outputDir());
+    }
+
+    auto verifier = std::optional<mc::CopyVerifier> {};
+    if (cli.verify()) {
+        verifier.emplace(cli.manifest() ? std::optional { cli.outputDir() } : std::nullopt);
+    }
+
+    mc::copy_stats().reset();
+    import_files<Operation>(cli, fileRegister, catalog, verifier ? &verifier.value() : nullptr);
+
+    spdlog::info("Removing duplicates in destination directory..");
+    fileRegister.removeDuplicates();
+
+    if (!simulate) {
+        fileRegister.store();
+    }
+    if (verifier.has_value()) {
+        verifier->store();
+    }
+    if (catalog.has_value() && !simulate) {
+        catalog->store();
+    }
+
+    mc::copy_stats().log();
+    spdlog::info("Done");
+    std::signal(SIGINT, SIG_DFL);
+}
+
+#ifdef __linux__
+template <typename Operation>
+auto watch(const mc::Cli& cli) -> void
+{
+    static constexpr const std::chrono::milliseconds POLL_INTERVAL { 500 };
+
+    std::signal(SIGINT, [](int) -> void {
+        operationCancelled.store(true);
+    });
+    std::signal(SIGTERM, [](int) -> void {
+        operationCancelled.store(true);
+    });
+
+    auto fileRegister = mc::FileRegister { cli.outputDir(), cli.pattern(), cli.useUtc(), cli.compareBudget() };
+    auto catalog = std::optional<mc::ImportCatalog> {};
+    if (cli.incremental()) {
+        catalog.emplace(cli.outputDir());
+    }
+
+    auto verifier = std::optional<mc::CopyVerifier> {};
+    if (cli.verify()) {
+        verifier.emplace(cli.manifest() ? std::optional { cli.outputDir() } : std::nullopt);
+    }
+
+    mc::copy_stats().reset();
+
+    // the watch is set up first, so nothing slips through while importing the existing files
+    auto watcher = mc::DirectoryWatcher { cli.inputDir(), cli.quietPeriod() };
+    import_files<Operation>(cli, fileRegister, catalog, verifier ? &verifier.value() : nullptr);
+    fileRegister.removeDuplicates();
+    fileRegister.store();
+    if (catalog.has_value()) {
+        catalog->store();
+    }
+    if (verifier.has_value()) {
+        verifier->store();
+    }
+
+    spdlog::info("Watching for new files in {0}..", cli.inputDir().string());
     std::optional<fs::path> dest;
 
-    for (auto file : media_files(cli.inputDir())) {
-        if (operationCancelled.load()) {
-            spdlog::warn("Operation was cancelled..");
-            break;
+    while (!operationCancelled.load()) {
+        auto files = watcher.poll(POLL_INTERVAL);
+        for (const auto& path : files) {
+            if (operationCancelled.load()) {
+                break;
+            }
+            const auto entry = mc::DirectoryWalker::status(path);
+            if (!entry.has_value()) {
+                continue; // already gone again
+            }
+            const auto outcome = process<Operation>(fileRegister, mc::MetadataProber::probe(entry.value(), {}), dest, verifier ? &verifier.value() : nullptr).value();
+            if (catalog.has_value()) {
+                catalog->record(entry.value(), outcome, outcome == Outcome::Imported ? dest.value() : fs::path {});
+            }
         }
-        try {
-            if (file != nullptr && (dest = fileRegister.add(file)).has_value()) {
-                spdlog::info("Processing: {0} -> {1}", file->path().string(), dest.value().string());
-                Operation op(dest.value());
-                file->accept(op);
+        if (!files.empty()) {
+            fileRegister.removeDuplicates();
+            fileRegister.store();
+            if (catalog.has_value()) {
+                catalog->store();
+            }
+            if (verifier.has_value()) {
+                verifier->store();
             }
-        } catch (const std::exception& err) {
-            spdlog::error(err.what());
         }
     }
 
-    spdlog::info("Removing duplicates in destination directory..");
-    fileRegister.removeDuplicates();
-
+    mc::copy_stats().log();
     spdlog::info("Done");
     std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
 }
+#endif
 
 int main(int argc, char* argv[])
 {
@@ -102,9 +293,23 @@ int main(int argc, char* argv[])
     case mc::Cli::Command::Move:
         exec<mediacopier::FileOperationMoveJpeg>(cli);
         break;
+    case mc::Cli::Command::Link:
+        exec<mediacopier::FileOperationLinkJpeg>(cli);
+        break;
     case mc::Cli::Command::Sim:
         exec<mediacopier::FileOperationSimulate>(cli);
         break;
+#ifdef __linux__
+    case mc::Cli::Command::Watch:
+        if (cli.watchMove()) {
+            watch<mediacopier::FileOperationMoveJpeg>(cli);
+        } else if (cli.watchLink()) {
+            watch<mediacopier::FileOperationLinkJpeg>(cli);
+        } else {
+            watch<mediacopier::FileOperationCopyJpeg>(cli);
+        }
+        break;
+#endif
     }
     cli.storePersistentConfig(outputDir);
     return 0;
@@ -59,7 +59,9 @@ public Q_SLOTS:
     void updateProgress(StatusProgress info)
     {
         setTotalAmount(Files, info.count);
+        setTotalAmount(Bytes, info.bytes);
         setProcessedAmount(Files, info.progress);
+        setProcessedAmount(Bytes, info.bytesProgress);
     }
     void quit()
     {
@@ -16,21 +16,38 @@
 
 #pragma once
 
+#include <chrono>
 #include <filesystem>
+#include <memory>
 
 namespace mediacopier {
 
 class AbstractFileOperation;
 
+struct Timestamp {
+    std::chrono::system_clock::time_point local;
+    std::chrono::minutes offset = std::chrono::minutes::zero();
+};
+
 class AbstractFileInfo {
 public:
     AbstractFileInfo(std::filesystem::path path)
         : m_path { std::move(path) }
     {
     }
+    AbstractFileInfo(std::filesystem::path path, const Timestamp& timestamp) noexcept
+        : m_path { std::move(path) }
+        , m_timestamp { timestamp.local }
+        , m_offset { timestamp.offset }
+    {
+    }
+    AbstractFileInfo(const AbstractFileInfo&) = default;
+    AbstractFileInfo(AbstractFileInfo&&) noexcept = default;
+    AbstractFileInfo& operator=(const AbstractFileInfo&) = default;
+    AbstractFileInfo& operator=(AbstractFileInfo&&) noexcept = default;
     virtual ~AbstractFileInfo() = default;
     virtual auto accept(AbstractFileOperation& operation) const -> void = 0;
-    auto path() const -> std::filesystem::path { return m_path; }
+    auto path() const noexcept -> const std::filesystem::path& { return m_path; }
     auto timestamp() const -> std::chrono::system_clock::time_point { return m_timestamp; }
     auto offset() const -> std::chrono::minutes { return m_offset; }
 
@@ -0,0 +1,57 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace mediacopier {
+
+/* Binary format shared by the catalogs in the output directory: a magic
+ * number, a version and the record count, followed by the records. They are
+ * local caches, so values are stored in host byte order. */
+
+template <typename T>
+auto write_value(std::ostream& os, const T& value) -> void
+{
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+auto read_value(std::istream& is, T& value) -> bool
+{
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// strings are prefixed with their length, longer ones than `maxLength` are rejected when reading
+auto write_string(std::ostream& os, std::string_view value) -> void;
+auto read_string(std::istream& is, std::string& value, uint32_t maxLength) -> bool;
+
+auto write_catalog_header(std::ostream& os, uint32_t magic, uint32_t version, uint64_t count) -> void;
+// returns the record count, or nothing if the magic number or the version don't match
+auto read_catalog_header(std::istream& is, uint32_t magic, uint32_t version) -> std::optional<uint64_t>;
+
+// written to a temporary file first, so an interrupted run never leaves a broken catalog
+auto store_catalog_file(const std::filesystem::path& path, const std::function<void(std::ostream&)>& write) -> void;
+
+} // namespace mediacopier
@@ -0,0 +1,65 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/content_hash.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mediacopier {
+
+/* Remembers the payload hash of every file imported into an output directory,
+ * so files already in the library are recognized without reading them again,
+ * regardless of their name. Records are only as good as the library is left
+ * alone, the caller is expected to check that the destination still exists. */
+
+class ContentCatalog {
+public:
+    struct Record {
+        uint64_t size = 0; // of the payload
+        int64_t timestamp = 0; // ns since epoch, local time of the file
+        std::string destination; // relative to the output directory
+        bool pending = false; // added by this run, dropped when storing if the destination is missing
+    };
+
+    explicit ContentCatalog(std::filesystem::path outputDir);
+
+    [[nodiscard]] auto containsSize(uint64_t size) const -> bool { return m_sizes.contains(size); }
+    [[nodiscard]] auto find(const ContentHash& hash) const -> const Record*;
+    auto add(const ContentHash& hash, Record record) -> void;
+    auto remove(const ContentHash& hash) -> void;
+    auto store() const -> void;
+    [[nodiscard]] auto size() const -> size_t { return m_records.size(); }
+
+private:
+    struct HashHash {
+        auto operator()(const ContentHash& hash) const noexcept -> size_t { return static_cast<size_t>(hash.h1); }
+    };
+
+    auto load() -> void;
+
+    std::filesystem::path m_outputDir;
+    std::filesystem::path m_catalogFile;
+    std::unordered_map<ContentHash, Record, HashHash> m_records;
+    std::unordered_multiset<uint64_t> m_sizes;
+};
+
+} // namespace mediacopier
@@ -0,0 +1,79 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace mediacopier {
+
+struct ContentHash {
+    uint64_t h1 = 0;
+    uint64_t h2 = 0;
+    auto operator==(const ContentHash&) const -> bool = default;
+};
+
+/* Streaming variant of MurmurHash3 (x64, 128 bit) by Austin Appleby, which
+ * is in the public domain. Any split of the input yields the same hash as
+ * the reference implementation over the whole input. It is fast, but not
+ * meant to resist deliberate collisions. */
+
+class Murmur3Hasher {
+public:
+    explicit Murmur3Hasher(uint64_t seed = 0) noexcept
+        : m_h1 { seed }
+        , m_h2 { seed }
+    {
+    }
+    auto update(std::span<const uint8_t> data) noexcept -> void;
+    auto finish() noexcept -> ContentHash;
+
+private:
+    auto block(const uint8_t* data) noexcept -> void;
+
+    uint64_t m_h1;
+    uint64_t m_h2;
+    uint64_t m_length = 0;
+    std::array<uint8_t, 16> m_tail {};
+    size_t m_tailSize = 0;
+};
+
+using Sha256Digest = std::array<uint8_t, 32>;
+
+// SHA-256 as in FIPS 180-4, slower than Murmur3 but the checksums can be checked with sha256sum
+class Sha256Hasher {
+public:
+    auto update(std::span<const uint8_t> data) noexcept -> void;
+    auto finish() noexcept -> Sha256Digest;
+
+private:
+    auto block(const uint8_t* data) noexcept -> void;
+
+    std::array<uint32_t, 8> m_state {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    uint64_t m_length = 0;
+    std::array<uint8_t, 64> m_tail {};
+    size_t m_tailSize = 0;
+};
+
+// lower case, as printed by sha256sum
+auto to_hex(const Sha256Digest& digest) -> std::string;
+
+} // namespace mediacopier
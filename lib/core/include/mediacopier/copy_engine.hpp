@@ -0,0 +1,78 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/content_hash.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace mediacopier {
+
+/* Copies whole files with the cheapest way the file systems support. A
+ * reflink shares the data blocks on btrfs and xfs, copy_file_range and
+ * sendfile stay within the kernel, anything else is read and written in
+ * large blocks. */
+
+enum class CopyMethod {
+    Hardlink, // only used by FileOperationLink
+    Reflink,
+    CopyFileRange,
+    Sendfile,
+    Buffered,
+    Uring, // only used by CopyExecutor
+};
+
+auto to_string(CopyMethod method) -> std::string_view;
+
+// counts the files and bytes per copy method, shared by all copies of a run
+class CopyStats {
+public:
+    struct Counter {
+        uint64_t files = 0;
+        uint64_t bytes = 0;
+    };
+
+    auto record(CopyMethod method, uint64_t bytes) noexcept -> void;
+    auto get(CopyMethod method) const noexcept -> Counter;
+    auto reset() noexcept -> void;
+    // logs the counters of the methods that were used
+    auto log() const -> void;
+
+private:
+    struct AtomicCounter {
+        std::atomic<uint64_t> files = 0;
+        std::atomic<uint64_t> bytes = 0;
+    };
+    std::array<AtomicCounter, 6> m_counters;
+};
+
+auto copy_stats() noexcept -> CopyStats&;
+
+// overwrites an existing destination and keeps the permissions, throws FileOperationError
+auto fast_copy(const std::filesystem::path& source, const std::filesystem::path& destination) -> CopyMethod;
+
+// like fast_copy, but the data passes through a buffer and is hashed on the way
+auto hashed_copy(const std::filesystem::path& source, const std::filesystem::path& destination) -> Sha256Digest;
+
+// flushes the file and drops it from the page cache first, so the hash covers what is stored on the disk
+auto hash_stored_file(const std::filesystem::path& path) -> Sha256Digest;
+
+} // namespace mediacopier
@@ -0,0 +1,96 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/device_scheduler.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace mediacopier {
+
+class CopyVerifier;
+
+/* Copies up to `depth` files at the same time, so that fast storage gets
+ * enough requests to work on. With io_uring each file is opened, read,
+ * written and closed by linked requests on registered buffers, otherwise
+ * a thread pool runs fast_copy, or the CopyVerifier if copies are
+ * verified. The DeviceScheduler holds copies back while their devices are
+ * busy, so they may start in a different order than they were submitted.
+ * Completions are returned in the order the copies finish. */
+
+class CopyExecutor {
+public:
+    static constexpr const size_t DEFAULT_DEPTH = 16;
+    static constexpr const size_t BUFFER_SIZE = 1024 * 1024;
+
+    struct Job {
+        std::filesystem::path source;
+        std::filesystem::path destination;
+        uint64_t tag = 0; // identifies the job for the caller
+    };
+
+    struct Completion {
+        Job job;
+        std::exception_ptr error = nullptr; // set if the copy failed, the destination was removed then
+    };
+
+    class Backend;
+
+    explicit CopyExecutor(size_t depth = DEFAULT_DEPTH, DeviceLimits limits = {}, CopyVerifier* verifier = nullptr);
+    ~CopyExecutor();
+    CopyExecutor(const CopyExecutor&) = delete;
+    CopyExecutor& operator=(const CopyExecutor&) = delete;
+    CopyExecutor(CopyExecutor&&) = delete;
+    CopyExecutor& operator=(CopyExecutor&&) = delete;
+
+    // blocks while `depth` copies are queued or in flight
+    auto submit(Job job) -> void;
+    // returns the copies that finished so far without blocking
+    auto poll() -> std::vector<Completion>;
+    // waits for all copies that were submitted
+    auto drain() -> std::vector<Completion>;
+
+private:
+    struct Pending {
+        Job job;
+        uint64_t bytes = 0;
+    };
+    struct Dispatched {
+        uint64_t tag = 0; // the tag of the caller, the backend sees an internal one
+        DeviceScheduler::Ticket ticket;
+    };
+
+    // hands queued copies to the backend as far as the scheduler allows
+    auto dispatch() -> void;
+    auto collect(bool wait) -> void;
+
+    size_t m_depth;
+    std::unique_ptr<Backend> m_backend;
+    DeviceScheduler m_scheduler;
+    std::deque<Pending> m_pending;
+    std::unordered_map<uint64_t, Dispatched> m_dispatched;
+    uint64_t m_nextId = 0;
+    std::vector<Completion> m_completions;
+};
+
+} // namespace mediacopier
@@ -0,0 +1,58 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/content_hash.hpp>
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace mediacopier {
+
+/* Proves that imported files are bit-exact before the sources are removed or
+ * the memory cards are wiped. The source is hashed while it is copied, and
+ * the destination is read back from the disk afterwards instead of the page
+ * cache. The checksums can be written to a manifest in the destination,
+ * which `sha256sum -c` understands. All methods may be called from several
+ * threads. */
+
+class CopyVerifier {
+public:
+    static constexpr const char* MANIFEST_NAME = "SHA256SUMS";
+
+    // without a manifest directory the checksums are only compared
+    explicit CopyVerifier(std::optional<std::filesystem::path> manifestDir = {});
+
+    // throws VerificationError if the destination differs from the source, it is removed then
+    auto copy(const std::filesystem::path& source, const std::filesystem::path& destination) -> void;
+    // adds a file that was renamed or transformed instead of copied to the manifest
+    auto record(const std::filesystem::path& path) -> void;
+    // adds the checksums collected since the last call to the manifest, replacing older ones of the same files
+    auto store() -> void;
+
+private:
+    auto add(const std::filesystem::path& path, const Sha256Digest& digest) -> void;
+
+    std::optional<std::filesystem::path> m_manifestDir;
+    std::vector<std::pair<std::filesystem::path, Sha256Digest>> m_checksums;
+    std::mutex m_mutex;
+};
+
+} // namespace mediacopier
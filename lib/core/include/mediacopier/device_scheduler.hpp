@@ -0,0 +1,83 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+namespace mediacopier {
+
+/* Decides how many copies may run at the same time on each device. Parallel
+ * requests make a spinning disk or an SD card seek back and forth, while a
+ * SSD or a network share only gets busy with several of them. The devices
+ * are looked up in /sys/dev/block by the st_dev of the files. */
+
+struct DeviceLimits {
+    size_t rotational = 1; // also used for removable media
+    size_t solidState = 4;
+    size_t network = 8;
+    uint64_t inFlightBytes = 512 * 1024 * 1024; // size of all files being copied
+};
+
+class DeviceScheduler {
+public:
+    enum class Kind {
+        Rotational,
+        Removable,
+        SolidState,
+        Network,
+        Unknown, // no block device (e.g. tmpfs or btrfs subvolumes), handled like a SSD
+    };
+
+    // returned by tryAcquire, must be released once the copy finished
+    struct Ticket {
+        uint64_t source = 0;
+        uint64_t destination = 0;
+        uint64_t bytes = 0;
+    };
+
+    explicit DeviceScheduler(DeviceLimits limits = {});
+
+    // the destination may not exist yet, then the device of the nearest existing parent is used
+    auto kind(const std::filesystem::path& path) -> Kind;
+    // a copy is always admitted if nothing is in flight, so large files don't wait forever
+    auto tryAcquire(const std::filesystem::path& source, const std::filesystem::path& destination, uint64_t bytes) -> std::optional<Ticket>;
+    auto release(const Ticket& ticket) -> void;
+
+    auto inFlightBytes() const -> uint64_t { return m_inFlightBytes; }
+
+private:
+    struct Device {
+        Kind kind = Kind::Unknown;
+        size_t limit = 1;
+        size_t inFlight = 0;
+    };
+
+    auto device(const std::filesystem::path& path) -> std::pair<const uint64_t, Device>&;
+
+    DeviceLimits m_limits;
+    std::unordered_map<uint64_t, Device> m_devices;
+    size_t m_inFlight = 0;
+    uint64_t m_inFlightBytes = 0;
+};
+
+auto to_string(DeviceScheduler::Kind kind) -> std::string_view;
+
+} // namespace mediacopier
@@ -0,0 +1,137 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace mediacopier {
+
+/* Walks a directory tree with a pool of threads and streams all regular files
+ * (including symlinks to regular files) to the consumer via a bounded queue.
+ * Every thread owns a deque of pending directories, idle threads steal from
+ * the others. The order of the resulting entries is not deterministic. */
+
+class DirectoryWalker {
+public:
+    static constexpr const size_t DEFAULT_QUEUE_CAPACITY = 4096;
+
+    struct Entry {
+        std::filesystem::path path;
+        // only available when file status was requested
+        uintmax_t size = 0;
+        uint64_t device = 0;
+        uint64_t inode = 0; // zero where not supported
+        std::chrono::system_clock::time_point modified {};
+    };
+
+    struct Progress {
+        size_t files = 0;
+        uintmax_t bytes = 0;
+        bool complete = false;
+    };
+
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry*;
+        using reference = const Entry&;
+
+        Iterator() = default;
+        explicit Iterator(DirectoryWalker* walker)
+            : m_walker { walker }
+        {
+            ++(*this);
+        }
+        auto operator*() const -> reference { return m_current.value(); }
+        auto operator->() const -> pointer { return &m_current.value(); }
+        auto operator++() -> Iterator&
+        {
+            m_current = m_walker->next();
+            if (!m_current.has_value()) {
+                m_walker = nullptr;
+            }
+            return *this;
+        }
+        auto operator++(int) -> void { ++(*this); }
+        auto operator==(std::default_sentinel_t /* end */) const -> bool { return m_walker == nullptr; }
+
+    private:
+        DirectoryWalker* m_walker = nullptr;
+        std::optional<Entry> m_current;
+    };
+
+    // throws std::filesystem::filesystem_error if the root directory can't be opened
+    explicit DirectoryWalker(std::filesystem::path root, bool statFiles = false, size_t threads = 0, size_t capacity = DEFAULT_QUEUE_CAPACITY);
+    ~DirectoryWalker();
+    DirectoryWalker(const DirectoryWalker&) = delete;
+    DirectoryWalker& operator=(const DirectoryWalker&) = delete;
+    DirectoryWalker(DirectoryWalker&&) = delete;
+    DirectoryWalker& operator=(DirectoryWalker&&) = delete;
+
+    static auto status(std::filesystem::path path) -> std::optional<Entry>;
+
+    auto next() -> std::optional<Entry>;
+    auto cancel() -> void;
+    auto progress() const -> Progress;
+    auto begin() -> Iterator { return Iterator { this }; }
+    auto end() -> std::default_sentinel_t { return std::default_sentinel; }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::filesystem::path> dirs;
+    };
+
+    auto run(size_t index) -> void;
+    auto acquire(size_t index) -> std::optional<std::filesystem::path>;
+    auto scan(const std::filesystem::path& dir, size_t index) -> void;
+    auto pushDirectory(std::filesystem::path dir, size_t index) -> void;
+    auto pushFile(Entry file) -> bool;
+    auto finish() -> void;
+
+    std::vector<WorkQueue> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_pending = 0; // directories queued or being scanned
+    std::atomic<size_t> m_queued = 0; // directories queued only
+    std::atomic<bool> m_cancelled = false;
+    std::atomic<bool> m_complete = false;
+    std::atomic<size_t> m_filesFound = 0;
+    std::atomic<uintmax_t> m_bytesFound = 0;
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCondition;
+
+    bool m_statFiles;
+    size_t m_capacity;
+    bool m_done = false;
+    std::deque<Entry> m_files;
+    std::mutex m_filesMutex;
+    std::condition_variable m_filesNotEmpty;
+    std::condition_variable m_filesNotFull;
+};
+
+} // namespace mediacopier
@@ -0,0 +1,64 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#ifdef __linux__
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace mediacopier {
+
+/* Watches a directory tree with inotify and reports files once they were
+ * written completely (closed after writing or moved into the tree) and
+ * haven't been touched again for the quiet period. Directories created
+ * later on are watched as well, files already inside them are reported. */
+
+class DirectoryWatcher {
+public:
+    static constexpr const std::chrono::milliseconds DEFAULT_QUIET_PERIOD { 2000 };
+
+    explicit DirectoryWatcher(std::filesystem::path root, std::chrono::milliseconds quietPeriod = DEFAULT_QUIET_PERIOD);
+    ~DirectoryWatcher();
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+    DirectoryWatcher(DirectoryWatcher&&) = delete;
+    DirectoryWatcher& operator=(DirectoryWatcher&&) = delete;
+
+    // waits at most `timeout` for new events, the result may be empty
+    auto poll(std::chrono::milliseconds timeout) -> std::vector<std::filesystem::path>;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    auto addWatches(const std::filesystem::path& dir, bool reportFiles) -> void;
+    auto removeWatches(const std::filesystem::path& dir) -> void;
+    auto readEvents() -> void;
+
+    int m_fd;
+    std::filesystem::path m_root;
+    std::chrono::milliseconds m_quietPeriod;
+    std::unordered_map<int, std::filesystem::path> m_watches;
+    std::map<std::filesystem::path, Clock::time_point> m_pending;
+};
+
+} // namespace mediacopier
+
+#endif
@@ -16,10 +16,28 @@
 
 #pragma once
 
+#include <mediacopier/content_hash.hpp>
+
+#include <cstdint>
 #include <filesystem>
+#include <optional>
 
 namespace mediacopier {
 
-auto is_duplicate(const std::filesystem::path& file1, const std::filesystem::path& file2) -> bool;
+// the part of a file that is compared, jpeg files are compared from their scan data on
+struct Payload {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+constexpr static const uint64_t DEFAULT_COMPARE_BUDGET = 8 * 1024;
+constexpr static const uint64_t FULL_COMPARE = UINT64_MAX;
+
+// compares the first `budget` bytes of both payloads, throws if one of the files doesn't exist
+auto is_duplicate(const std::filesystem::path& file1, const std::filesystem::path& file2, uint64_t budget = DEFAULT_COMPARE_BUDGET) -> bool;
+
+// both return an empty value if the file can't be read
+auto locate_payload(const std::filesystem::path& file) -> std::optional<Payload>;
+auto hash_payload(const std::filesystem::path& file, const Payload& payload) -> std::optional<ContentHash>;
 
 } // namespace mediacopier
@@ -0,0 +1,75 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/duplicate_check.hpp>
+#include <mediacopier/path_table.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace mediacopier {
+
+/* Compares files by a hash of their payload, see locate_payload. Every file
+ * is read at most once, and only if there is another file with a payload of
+ * the same size. The results are kept for the lifetime of the index, so the
+ * files are expected not to change meanwhile. The hash doesn't resist
+ * deliberate collisions, so if it matches the first `compareBudget` bytes of
+ * both payloads are compared with is_duplicate as well. FULL_COMPARE rules
+ * out any collision, 0 trusts the hash. */
+
+class DuplicateIndex {
+public:
+    explicit DuplicateIndex(uint64_t compareBudget = DEFAULT_COMPARE_BUDGET);
+
+    // returns an added file with the same payload, the file itself is not reported
+    auto find(const std::filesystem::path& file) -> std::optional<std::filesystem::path>;
+    auto add(const std::filesystem::path& file) -> void;
+    auto remove(const std::filesystem::path& file) -> void;
+    // forgets all files, e.g. once they are in the content catalog
+    auto clear() -> void;
+
+    // throws if one of the files can't be read
+    auto same(const std::filesystem::path& file1, const std::filesystem::path& file2) -> bool;
+
+    // throw if the file can't be read
+    auto payloadSize(const std::filesystem::path& file) -> uint64_t;
+    auto payloadHash(const std::filesystem::path& file) -> ContentHash;
+    // the hash if it was computed already, the file is not read
+    auto knownHash(const std::filesystem::path& file) const -> std::optional<ContentHash>;
+
+private:
+    struct Record {
+        PathTable::Handle handle;
+        Payload payload;
+        std::optional<ContentHash> hash;
+        bool added = false;
+    };
+
+    auto record(const std::filesystem::path& file) -> Record&;
+    auto hash(Record& record) -> bool;
+    auto equal(Record& record1, Record& record2) -> bool;
+
+    uint64_t m_compareBudget;
+    PathTable m_paths;
+    std::unordered_map<PathTable::Handle, Record> m_records;
+    std::unordered_map<uint64_t, std::vector<PathTable::Handle>> m_sizes;
+};
+
+} // namespace mediacopier
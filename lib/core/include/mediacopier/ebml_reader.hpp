@@ -0,0 +1,36 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/file_source.hpp>
+
+#include <optional>
+#include <string>
+
+namespace mediacopier {
+
+/* Native reader for matroska and webm files. The segment is walked up to the
+ * first cluster, which is where muxers put 'Info' and usually the global tags,
+ * so only the first few KiB of a file are read. */
+
+// the creation date in the format libav reports it, a global 'creation_time'
+// tag is preferred over 'Info/DateUTC', an empty optional means the file
+// couldn't be walked or there is no date before the first cluster (the tags
+// may follow the clusters, libav finds them through the seek head)
+auto read_matroska_creation_time(FileSource& source) -> std::optional<std::string>;
+
+} // namespace mediacopier
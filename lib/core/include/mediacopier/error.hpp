@@ -17,6 +17,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <string>
 
 namespace mediacopier {
 
@@ -36,4 +37,19 @@ class FileOperationError : public MediaCopierError {
     using MediaCopierError::MediaCopierError;
 };
 
+class VerificationError : public FileOperationError {
+    using FileOperationError::FileOperationError;
+};
+
+// returned instead of thrown while probing, files that fail are common
+struct ProbeError {
+    enum class Reason {
+        UnknownType,
+        NoMetadata,
+        InvalidMetadata,
+    };
+    Reason reason;
+    std::string message;
+};
+
 } // namespace mediacopier
@@ -0,0 +1,67 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/file_source.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace mediacopier {
+
+/* The few exif tags needed for constructing image file infos. All values are
+ * views into the parsed buffer (or strings owned by the caller), missing tags
+ * are left default constructed (nullptr data). Entries are ordered by priority:
+ * original, digitized, plain (image) date time. */
+
+struct ExifTags {
+    std::array<std::string_view, 3> dateTime;
+    std::array<std::string_view, 3> subSec;
+    std::array<std::string_view, 3> offset;
+    uint16_t orientation = 0; // zero if missing
+};
+
+struct ExifLocation {
+    size_t offset = 0;
+    size_t size = 0; // zero if there is no exif data
+};
+
+// locates the tiff structure within the APP1 segment of a jpeg file, empty if
+// the segments can't be followed within the given data
+auto locate_jpeg_exif(std::span<const uint8_t> jpeg) noexcept -> std::optional<ExifLocation>;
+
+// reads IFD0 and the exif IFD of a tiff structure, empty if the data is
+// malformed or incomplete, the caller is expected to fall back to exiv2 then
+auto read_exif_tags(std::span<const uint8_t> tiff) noexcept -> std::optional<ExifTags>;
+
+// same for a tiff structure at `offset` within a file (tiff based raw formats,
+// embedded previews), the values stay valid as long as the source is alive
+auto read_exif_tags(FileSource& source, uint64_t offset = 0) -> std::optional<ExifTags>;
+
+enum class TiffIfd {
+    Image,
+    Exif,
+};
+
+// adds the tags of a single IFD to `tags`, canon cr3 files store IFD0 and the
+// exif IFD as separate tiff structures
+auto read_exif_ifd_tags(FileSource& source, uint64_t offset, TiffIfd ifd, ExifTags& tags) -> bool;
+
+} // namespace mediacopier
@@ -0,0 +1,48 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/file_info_image.hpp>
+#include <mediacopier/file_info_image_jpeg.hpp>
+#include <mediacopier/file_info_video.hpp>
+
+#include <filesystem>
+#include <utility>
+#include <variant>
+
+namespace mediacopier {
+
+/* Value type for the probed files. Compared to FileInfoPtr it needs no heap
+ * allocation, and operations are dispatched with std::visit instead of the
+ * virtual accept/visit pair. */
+
+using FileInfo = std::variant<FileInfoImage, FileInfoImageJpeg, FileInfoVideo>;
+
+inline auto file_info_base(const FileInfo& file) noexcept -> const AbstractFileInfo&
+{
+    return std::visit([](const AbstractFileInfo& info) -> const AbstractFileInfo& { return info; }, file);
+}
+
+// the qualified call binds statically to the given operation type, there is no virtual dispatch involved
+template <typename Operation, typename... Args>
+auto execute_operation(std::filesystem::path destination, const FileInfo& file, Args&&... args) -> void
+{
+    Operation operation { std::move(destination), std::forward<Args>(args)... };
+    std::visit([&operation](const auto& info) { operation.Operation::visit(info); }, file);
+}
+
+} // namespace mediacopier
@@ -16,13 +16,57 @@
 
 #pragma once
 
-#include <mediacopier/abstract_file_info.hpp>
+#include <mediacopier/error.hpp>
+#include <mediacopier/file_info.hpp>
 
+#include <cstdint>
+#include <expected>
 #include <filesystem>
+#include <optional>
+#include <span>
 
 namespace mediacopier {
 
+enum class FileType {
+    Unknown,
+    // images, handled by exiv2
+    Jpeg,
+    Tiff, // including most tiff based raw formats (dng, cr2, nef, arw, ..)
+    Orf,
+    Rw2,
+    Raf,
+    Crw,
+    Mrw,
+    Png,
+    Webp,
+    Psd,
+    Jp2,
+    Heif, // including avif and cr3
+    // videos, handled by libavformat
+    Isobmff,
+    QuickTime,
+    Matroska,
+    Avi,
+    Asf,
+    Flv,
+    Ogg,
+    MpegPs,
+    MpegTs,
+    M2ts,
+};
+
+auto detect_file_type(std::span<const uint8_t> header) noexcept -> FileType;
+auto is_image_type(FileType type) noexcept -> bool;
+
+// the header is used for detecting the file type, see HeaderPrefetcher
+auto probe(const std::filesystem::path& path) -> std::expected<FileInfo, ProbeError>;
+auto probe(const std::filesystem::path& path, std::span<const uint8_t> header) -> std::expected<FileInfo, ProbeError>;
+
+// same as above, errors are logged and an empty value is returned instead
+auto to_file_info(const std::filesystem::path& path) -> std::optional<FileInfo>;
+auto to_file_info(const std::filesystem::path& path, std::span<const uint8_t> header) -> std::optional<FileInfo>;
 auto to_file_info_ptr(const std::filesystem::path& path) -> FileInfoPtr;
+auto to_file_info_ptr(const std::filesystem::path& path, std::span<const uint8_t> header) -> FileInfoPtr;
 
 class FileInfoFactory {
 public:
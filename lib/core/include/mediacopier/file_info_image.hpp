@@ -17,15 +17,24 @@
 #pragma once
 
 #include <mediacopier/abstract_file_info.hpp>
+#include <mediacopier/error.hpp>
+#include <mediacopier/exif_reader.hpp>
 
 #include <exiv2/exiv2.hpp>
 
+#include <expected>
+
 namespace mediacopier {
 
 class FileInfoImage : public AbstractFileInfo {
 public:
     FileInfoImage(std::filesystem::path path, Exiv2::ExifData& exif);
+    FileInfoImage(std::filesystem::path path, const ExifTags& tags);
+    FileInfoImage(std::filesystem::path path, const Timestamp& timestamp) noexcept;
     auto accept(AbstractFileOperation& operation) const -> void override;
+
+    static auto readTimestamp(Exiv2::ExifData& exif) -> std::expected<Timestamp, ProbeError>;
+    static auto readTimestamp(const ExifTags& tags) -> std::expected<Timestamp, ProbeError>;
 };
 
 } // namespace mediacopier
@@ -35,9 +35,14 @@ public:
         ROT_90,
     };
     FileInfoImageJpeg(std::filesystem::path path, Exiv2::ExifData& exif);
+    FileInfoImageJpeg(std::filesystem::path path, const ExifTags& tags);
+    FileInfoImageJpeg(std::filesystem::path path, const Timestamp& timestamp, Orientation orientation) noexcept;
     auto accept(AbstractFileOperation& operation) const -> void override;
     auto orientation() const noexcept -> Orientation { return m_orientation; }
 
+    static auto readOrientation(Exiv2::ExifData& exif) -> std::expected<Orientation, ProbeError>;
+    static auto readOrientation(const ExifTags& tags) -> std::expected<Orientation, ProbeError>;
+
 private:
     Orientation m_orientation = Orientation::ROT_0;
 };
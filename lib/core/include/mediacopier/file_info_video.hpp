@@ -17,13 +17,26 @@
 #pragma once
 
 #include <mediacopier/abstract_file_info.hpp>
+#include <mediacopier/error.hpp>
+
+#include <expected>
+#include <string_view>
 
 namespace mediacopier {
 
 class FileInfoVideo : public AbstractFileInfo {
 public:
     explicit FileInfoVideo(std::filesystem::path path);
+    FileInfoVideo(std::filesystem::path path, std::string_view timestamp);
+    FileInfoVideo(std::filesystem::path path, const Timestamp& timestamp) noexcept;
     auto accept(AbstractFileOperation& operation) const -> void override;
+
+    // reads the container metadata with libavformat
+    static auto readTimestamp(const std::filesystem::path& path) -> std::expected<Timestamp, ProbeError>;
+    static auto parseTimestamp(std::string_view timestamp) -> std::expected<Timestamp, ProbeError>;
+
+private:
+    auto setTimestamp(const std::expected<Timestamp, ProbeError>& timestamp) -> void;
 };
 
 } // namespace mediacopier
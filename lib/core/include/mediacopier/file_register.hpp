@@ -17,30 +17,67 @@
 #pragma once
 
 #include <mediacopier/abstract_file_info.hpp>
+#include <mediacopier/content_catalog.hpp>
+#include <mediacopier/duplicate_index.hpp>
+#include <mediacopier/naming_pattern.hpp>
+#include <mediacopier/path_table.hpp>
 
 #include <filesystem>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace mediacopier {
 
-using FileInfoMap = std::unordered_map<std::string, FileInfoPtr>;
-using FileConflictMap = std::unordered_map<std::string, std::vector<std::filesystem::path>>;
+// maps the registered destination paths to their source
+using FileSourceMap = std::unordered_map<PathTable::Handle, PathTable::Handle>;
+using FileConflictMap = std::unordered_map<PathTable::Handle, std::vector<PathTable::Handle>>;
+// file names in the destination directories, read once when first needed
+using DirectoryListingMap = std::unordered_map<std::string, std::unordered_set<std::string>>;
 
 class FileRegister {
 public:
-    explicit FileRegister(std::filesystem::path destination, std::string pattern, bool useUtc);
-    auto add(FileInfoPtr file) -> std::optional<std::filesystem::path>;
+    // see DuplicateIndex for the compare budget
+    explicit FileRegister(std::filesystem::path destination, std::string pattern, bool useUtc, uint64_t compareBudget = DEFAULT_COMPARE_BUDGET);
+    auto add(const AbstractFileInfo& file) -> std::optional<std::filesystem::path>;
+    auto add(const FileInfoPtr& file) -> std::optional<std::filesystem::path> { return add(*file); }
+    // destinations copied in the background, they are compared through their source until finished
+    auto setPending(const std::filesystem::path& destination) -> void;
+    auto setFinished(const std::filesystem::path& destination) -> void;
     auto removeDuplicates() -> void;
+    /* Writes the content catalog of the destination directory, files imported
+     * meanwhile are added. Once no copy is pending, the register starts over
+     * from the catalog and the destination directories are listed again, so a
+     * long running register sees files written by others and doesn't grow. */
+    auto store() -> void;
 
 private:
-    auto constructDestinationPath(const FileInfoPtr&, size_t) const -> std::filesystem::path;
+    // catalog entries of registered files, hashed when storing if the operation wrote them
+    struct Imported {
+        PathTable::Handle source;
+        PathTable::Handle destination;
+        uint64_t size;
+        int64_t timestamp;
+    };
+
+    // renders the destination without suffix and extension into m_buffer, the suffixes only replace its tail
+    auto renderDestination(const AbstractFileInfo&) -> void;
+    auto constructDestinationPath(const AbstractFileInfo&, size_t) -> std::filesystem::path;
+    auto existedBefore(const std::filesystem::path& path) -> bool;
     std::filesystem::path m_destdir;
-    std::string m_pattern;
+    NamingPattern m_pattern;
     bool m_useUtc;
-    FileInfoMap m_register;
+    std::string m_buffer;
+    size_t m_stemLength = 0;
+    PathTable m_paths;
+    FileSourceMap m_register;
     FileConflictMap m_conflicts;
+    DirectoryListingMap m_listings;
+    DuplicateIndex m_duplicates;
+    ContentCatalog m_catalog;
+    std::vector<Imported> m_imported;
+    std::unordered_set<PathTable::Handle> m_pending;
 };
 
 } // namespace mediacopier
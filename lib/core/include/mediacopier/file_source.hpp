@@ -0,0 +1,63 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+namespace mediacopier {
+
+/* Bounded random access to a file for the native metadata readers. Reads are
+ * served from the prefetched header when possible, everything else is read
+ * in aligned blocks and kept until the source is destroyed, so returned views
+ * stay valid. Reads fail once the limit is exceeded, the callers are expected
+ * to fall back to exiv2 or libav then. */
+
+class FileSource {
+public:
+    static constexpr const size_t BLOCK_SIZE = 4 * 1024;
+    static constexpr const size_t DEFAULT_READ_LIMIT = 256 * 1024;
+
+    explicit FileSource(std::filesystem::path path, std::span<const uint8_t> header = {}, size_t readLimit = DEFAULT_READ_LIMIT);
+
+    // returns an empty view if the range isn't available (end of file, read error, limit exceeded)
+    auto read(uint64_t offset, size_t length) -> std::span<const uint8_t>;
+    auto size() -> uint64_t;
+    auto bytesRead() const noexcept -> size_t { return m_bytesRead; }
+
+private:
+    struct Extent {
+        uint64_t offset;
+        std::vector<uint8_t> data;
+    };
+
+    auto open() -> bool;
+
+    std::filesystem::path m_path;
+    std::span<const uint8_t> m_header;
+    size_t m_readLimit;
+    size_t m_bytesRead = 0;
+    uint64_t m_size = 0;
+    bool m_opened = false;
+    std::ifstream m_input;
+    std::vector<Extent> m_extents;
+};
+
+} // namespace mediacopier
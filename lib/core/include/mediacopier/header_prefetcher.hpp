@@ -0,0 +1,103 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/directory_walker.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mediacopier {
+
+/* Reads the first bytes of the next `depth` files of a DirectoryWalker stream
+ * asynchronously (io_uring when available, a thread pool otherwise), so that
+ * probing the metadata doesn't have to wait for the storage. Entries are
+ * returned in the order given by the walker. */
+
+class HeaderPrefetcher {
+public:
+    static constexpr const size_t DEFAULT_DEPTH = 32;
+    static constexpr const size_t DEFAULT_HEADER_SIZE = 64 * 1024;
+
+    struct Entry {
+        DirectoryWalker::Entry file;
+        std::vector<uint8_t> header; // may be shorter than requested (small files, read errors)
+    };
+
+    // entries are dropped before any data is read when the filter returns false
+    using Filter = std::function<bool(const DirectoryWalker::Entry&)>;
+
+    class Backend;
+    struct Slot;
+
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry*;
+        using reference = const Entry&;
+
+        Iterator() = default;
+        explicit Iterator(HeaderPrefetcher* prefetcher)
+            : m_prefetcher { prefetcher }
+        {
+            ++(*this);
+        }
+        auto operator*() const -> reference { return m_current.value(); }
+        auto operator->() const -> pointer { return &m_current.value(); }
+        auto operator++() -> Iterator&
+        {
+            m_current = m_prefetcher->next();
+            if (!m_current.has_value()) {
+                m_prefetcher = nullptr;
+            }
+            return *this;
+        }
+        auto operator++(int) -> void { ++(*this); }
+        auto operator==(std::default_sentinel_t /* end */) const -> bool { return m_prefetcher == nullptr; }
+
+    private:
+        HeaderPrefetcher* m_prefetcher = nullptr;
+        std::optional<Entry> m_current;
+    };
+
+    explicit HeaderPrefetcher(DirectoryWalker& walker, size_t depth = DEFAULT_DEPTH, size_t headerSize = DEFAULT_HEADER_SIZE);
+    ~HeaderPrefetcher();
+    HeaderPrefetcher(const HeaderPrefetcher&) = delete;
+    HeaderPrefetcher& operator=(const HeaderPrefetcher&) = delete;
+    HeaderPrefetcher(HeaderPrefetcher&&) = delete;
+    HeaderPrefetcher& operator=(HeaderPrefetcher&&) = delete;
+
+    auto next() -> std::optional<Entry>;
+    auto setFilter(Filter filter) -> void { m_filter = std::move(filter); }
+    auto begin() -> Iterator { return Iterator { this }; }
+    auto end() -> std::default_sentinel_t { return std::default_sentinel; }
+
+private:
+    DirectoryWalker& m_walker;
+    Filter m_filter;
+    size_t m_depth;
+    bool m_exhausted = false;
+    std::unique_ptr<Backend> m_backend;
+    std::deque<std::unique_ptr<Slot>> m_slots;
+};
+
+} // namespace mediacopier
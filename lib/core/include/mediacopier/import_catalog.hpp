@@ -0,0 +1,75 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/directory_walker.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+namespace mediacopier {
+
+/* Remembers the outcome for every source file that was handled by a previous
+ * run into the same output directory. Files are identified by device and inode,
+ * a file counts as unchanged as long as size and modification time match.
+ * Records that haven't been seen for a while are dropped when storing. */
+
+class ImportCatalog {
+public:
+    enum class Outcome : uint8_t {
+        Imported = 1,
+        Duplicate,
+        NotMedia,
+        Error, // retried on the next run
+    };
+
+    struct Record {
+        uintmax_t size = 0;
+        int64_t modified = 0; // ns since epoch
+        int64_t seen = 0; // s since epoch
+        Outcome outcome = Outcome::Error;
+        std::string destination;
+    };
+
+    explicit ImportCatalog(std::filesystem::path outputDir);
+
+    [[nodiscard]] auto find(const DirectoryWalker::Entry& entry) const -> const Record*;
+    [[nodiscard]] auto isUnchanged(const DirectoryWalker::Entry& entry) -> bool;
+    auto record(const DirectoryWalker::Entry& entry, Outcome outcome, const std::filesystem::path& destination = {}) -> void;
+    auto store() const -> void;
+    [[nodiscard]] auto size() const -> size_t { return m_records.size(); }
+
+private:
+    struct Key {
+        uint64_t device;
+        uint64_t inode;
+        auto operator==(const Key&) const -> bool = default;
+    };
+    struct KeyHash {
+        auto operator()(const Key& key) const noexcept -> size_t;
+    };
+
+    auto load() -> void;
+
+    std::filesystem::path m_catalogFile;
+    int64_t m_now;
+    std::unordered_map<Key, Record, KeyHash> m_records;
+};
+
+} // namespace mediacopier
@@ -0,0 +1,40 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/exif_reader.hpp>
+#include <mediacopier/file_source.hpp>
+
+#include <optional>
+#include <string>
+
+namespace mediacopier {
+
+/* Native readers for ISO base media files (mp4, mov, heic, avif, cr3). Only
+ * box headers are read while walking the file, so large 'mdat' boxes are
+ * skipped without touching their content. An empty optional means the file
+ * couldn't be walked, the caller is expected to fall back to libav or exiv2. */
+
+// the creation date in the format libav reports it, 'com.apple.quicktime.creationdate'
+// is preferred over 'moov/mvhd', an empty string means there is no date in the file
+auto read_isobmff_creation_time(FileSource& source) -> std::optional<std::string>;
+
+// exif tags of heif/avif 'Exif' items and canon cr3 'CMT1'/'CMT2' boxes, also
+// empty if there are none, the values stay valid as long as the source is alive
+auto read_isobmff_exif_tags(FileSource& source) -> std::optional<ExifTags>;
+
+} // namespace mediacopier
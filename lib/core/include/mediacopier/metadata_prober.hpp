@@ -0,0 +1,115 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mediacopier/file_info.hpp>
+#include <mediacopier/header_prefetcher.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace mediacopier {
+
+/* Runs the metadata probing of a HeaderPrefetcher stream on a thread pool.
+ * Results are returned in the order given by the prefetcher, so registering
+ * them yields the same destination names as a serial run. */
+
+class MetadataProber {
+public:
+    struct Entry {
+        DirectoryWalker::Entry file;
+        std::optional<FileInfo> info = std::nullopt; // empty if it is no media file
+        std::exception_ptr error = nullptr; // set if probing failed
+    };
+
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry*;
+        using reference = const Entry&;
+
+        Iterator() = default;
+        explicit Iterator(MetadataProber* prober)
+            : m_prober { prober }
+        {
+            ++(*this);
+        }
+        auto operator*() const -> reference { return m_current.value(); }
+        auto operator->() const -> pointer { return &m_current.value(); }
+        auto operator++() -> Iterator&
+        {
+            m_current = m_prober->next();
+            if (!m_current.has_value()) {
+                m_prober = nullptr;
+            }
+            return *this;
+        }
+        auto operator++(int) -> void { ++(*this); }
+        auto operator==(std::default_sentinel_t /* end */) const -> bool { return m_prober == nullptr; }
+
+    private:
+        MetadataProber* m_prober = nullptr;
+        std::optional<Entry> m_current;
+    };
+
+    // zero threads uses one thread per core
+    explicit MetadataProber(HeaderPrefetcher& prefetcher, size_t threads = 0);
+    ~MetadataProber();
+    MetadataProber(const MetadataProber&) = delete;
+    MetadataProber& operator=(const MetadataProber&) = delete;
+    MetadataProber(MetadataProber&&) = delete;
+    MetadataProber& operator=(MetadataProber&&) = delete;
+
+    // probes a single file on the calling thread, the header may be empty
+    static auto probe(DirectoryWalker::Entry file, std::span<const uint8_t> header) -> Entry;
+
+    auto next() -> std::optional<Entry>;
+    auto begin() -> Iterator { return Iterator { this }; }
+    auto end() -> std::default_sentinel_t { return std::default_sentinel; }
+
+private:
+    struct Slot {
+        HeaderPrefetcher::Entry input;
+        Entry result;
+        bool done = false;
+    };
+
+    auto run() -> void;
+
+    HeaderPrefetcher& m_prefetcher;
+    bool m_exhausted = false;
+    bool m_stopped = false;
+    // allocated once and reused in turn, results are handed out from m_head
+    std::vector<Slot> m_slots;
+    size_t m_head = 0;
+    size_t m_pending = 0;
+    std::deque<Slot*> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_submitted;
+    std::condition_variable m_completed;
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace mediacopier
@@ -0,0 +1,68 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mediacopier {
+
+/* Destination naming pattern, e.g. '%Y/%W/IMG_%Y%m%d_%H%M%S'. The text up to
+ * the first conversion specifier is taken as is, the rest is formatted like a
+ * std::chrono format spec. Patterns made of the common specifiers are
+ * compiled into a list of tokens, all others are passed to std::vformat. */
+
+class NamingPattern {
+public:
+    explicit NamingPattern(std::string pattern);
+
+    // appends the formatted time point to `output`
+    auto render(std::chrono::system_clock::time_point tp, std::string& output) const -> void;
+    auto compiled() const noexcept -> bool { return !m_tokens.empty(); }
+
+private:
+    enum class Field : uint8_t {
+        Literal,
+        Year,
+        YearOfCentury,
+        Month,
+        Day,
+        DayOfYear,
+        Hour,
+        Minute,
+        Second,
+        WeekOfYearSunday,
+        WeekOfYearMonday,
+    };
+    struct Token {
+        Field field;
+        uint32_t offset = 0; // literal text in m_literals
+        uint32_t length = 0;
+    };
+
+    auto compile(const std::string& pattern) -> bool;
+    auto renderFormat(std::chrono::system_clock::time_point tp, std::string& output) const -> void;
+
+    std::string m_format; // fallback, the pattern as std::format string
+    std::string m_literals;
+    std::vector<Token> m_tokens;
+    bool m_default = false;
+};
+
+} // namespace mediacopier
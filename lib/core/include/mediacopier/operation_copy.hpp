@@ -21,10 +21,13 @@
 
 namespace mediacopier {
 
+class CopyVerifier;
+
 class FileOperationCopy : public AbstractFileOperation {
 public:
-    explicit FileOperationCopy(std::filesystem::path destination)
+    explicit FileOperationCopy(std::filesystem::path destination, CopyVerifier* verifier = nullptr)
         : m_destination { std::move(destination) }
+        , m_verifier { verifier }
     {
     }
     auto visit(const FileInfoImage& file) -> void override;
@@ -34,6 +37,7 @@ public:
 protected:
     auto copyFile(const AbstractFileInfo& file) const -> void;
     std::filesystem::path m_destination;
+    CopyVerifier* m_verifier; // copies are verified if set
 };
 
 } // namespace mediacopier
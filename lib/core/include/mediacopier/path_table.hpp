@@ -0,0 +1,65 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mediacopier {
+
+/* Interning table for paths, each directory is stored once and file names
+ * are packed into shared blocks. Paths are referred to by compact handles,
+ * the stored strings stay valid as long as the table exists. */
+
+class PathTable {
+public:
+    using Handle = uint32_t;
+
+    auto intern(const std::filesystem::path& path) -> Handle;
+    auto find(const std::filesystem::path& path) const -> std::optional<Handle>;
+
+    auto path(Handle handle) const -> std::filesystem::path;
+    auto directory(Handle handle) const -> std::string_view;
+    auto filename(Handle handle) const -> std::string_view;
+    auto size() const noexcept -> size_t { return m_entries.size(); }
+
+private:
+    struct Directory {
+        std::string_view path;
+        std::unordered_map<std::string_view, Handle> files;
+    };
+    struct Entry {
+        uint32_t directory;
+        std::string_view filename;
+    };
+
+    auto store(std::string_view value) -> std::string_view;
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char* m_cursor = nullptr;
+    size_t m_blockFree = 0;
+    std::vector<Directory> m_directories;
+    std::unordered_map<std::string_view, uint32_t> m_directoryIds;
+    std::vector<Entry> m_entries;
+};
+
+} // namespace mediacopier
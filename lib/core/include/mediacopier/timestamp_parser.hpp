@@ -0,0 +1,44 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string_view>
+
+namespace mediacopier {
+
+/* Parsers for the fixed timestamp layouts found in exif data and video
+ * containers. They don't allocate and only accept the exact layout, anything
+ * else (including out of range values) yields an empty optional and is left
+ * to std::chrono::parse by the callers. */
+
+struct IsoTimestamp {
+    std::chrono::system_clock::time_point local; // as written, without applying the offset
+    std::optional<std::chrono::minutes> offset; // empty if there is no zone designator
+};
+
+// 'YYYY:MM:DD HH:MM:SS[.fff]', the sub seconds are stored in separate exif tags
+auto parse_exif_timestamp(std::string_view dateTime, std::string_view subSec = {}) noexcept -> std::optional<std::chrono::system_clock::time_point>;
+
+// '+HH:MM' or '-HH:MM'
+auto parse_utc_offset(std::string_view offset) noexcept -> std::optional<std::chrono::minutes>;
+
+// 'YYYY-MM-DDTHH:MM:SS[.fff][Z|+HH:MM|+HHMM|+HH]'
+auto parse_iso_timestamp(std::string_view timestamp) noexcept -> std::optional<IsoTimestamp>;
+
+} // namespace mediacopier
@@ -0,0 +1,83 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/catalog_file.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace mediacopier {
+
+auto write_string(std::ostream& os, std::string_view value) -> void
+{
+    write_value(os, static_cast<uint32_t>(value.size()));
+    os.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+auto read_string(std::istream& is, std::string& value, uint32_t maxLength) -> bool
+{
+    uint32_t length = 0;
+    if (!read_value(is, length) || length > maxLength) {
+        return false;
+    }
+    value.resize(length);
+    return static_cast<bool>(is.read(value.data(), length));
+}
+
+auto write_catalog_header(std::ostream& os, uint32_t magic, uint32_t version, uint64_t count) -> void
+{
+    write_value(os, magic);
+    write_value(os, version);
+    write_value(os, count);
+}
+
+auto read_catalog_header(std::istream& is, uint32_t magic, uint32_t version) -> std::optional<uint64_t>
+{
+    uint32_t fileMagic = 0;
+    uint32_t fileVersion = 0;
+    uint64_t count = 0;
+    if (!read_value(is, fileMagic) || !read_value(is, fileVersion) || !read_value(is, count)
+        || fileMagic != magic || fileVersion != version) {
+        return {};
+    }
+    return count;
+}
+
+auto store_catalog_file(const fs::path& path, const std::function<void(std::ostream&)>& write) -> void
+{
+    auto temporaryFile = path;
+    temporaryFile += ".tmp";
+    {
+        std::ofstream os { temporaryFile, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc };
+        write(os);
+        if (!os.flush()) {
+            spdlog::warn("Could not write catalog: {0}", temporaryFile.string());
+            return;
+        }
+    }
+    std::error_code err;
+    fs::rename(temporaryFile, path, err);
+    if (err) {
+        spdlog::warn("Could not replace catalog ({0}): {1}", path.string(), err.message());
+        fs::remove(temporaryFile, err);
+    }
+}
+
+} // namespace mediacopier
@@ -0,0 +1,120 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/content_catalog.hpp>
+
+#include <mediacopier/catalog_file.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <fstream>
+#include <vector>
+
+constexpr static const char* CONTENT_CATALOG = ".mediacopier-index";
+constexpr static const uint32_t CONTENT_CATALOG_MAGIC = 0x4d434458; // "MCDX"
+constexpr static const uint32_t CONTENT_CATALOG_VERSION = 1;
+constexpr static const uint32_t MAX_DESTINATION_LENGTH = 4096;
+
+namespace fs = std::filesystem;
+
+namespace mediacopier {
+
+ContentCatalog::ContentCatalog(fs::path outputDir)
+    : m_outputDir { std::move(outputDir) }
+    , m_catalogFile { m_outputDir / CONTENT_CATALOG }
+{
+    load();
+}
+
+auto ContentCatalog::find(const ContentHash& hash) const -> const Record*
+{
+    const auto it = m_records.find(hash);
+    if (it == m_records.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+auto ContentCatalog::add(const ContentHash& hash, Record record) -> void
+{
+    remove(hash);
+    m_sizes.insert(record.size);
+    m_records.emplace(hash, std::move(record));
+}
+
+auto ContentCatalog::remove(const ContentHash& hash) -> void
+{
+    const auto it = m_records.find(hash);
+    if (it == m_records.end()) {
+        return;
+    }
+    m_sizes.erase(m_sizes.find(it->second.size));
+    m_records.erase(it);
+}
+
+auto ContentCatalog::load() -> void
+{
+    std::ifstream is { m_catalogFile, std::ios_base::in | std::ios_base::binary };
+    if (!is.is_open()) {
+        return;
+    }
+    const auto count = read_catalog_header(is, CONTENT_CATALOG_MAGIC, CONTENT_CATALOG_VERSION);
+    if (!count.has_value()) {
+        spdlog::warn("Ignoring unknown content catalog: {0}", m_catalogFile.string());
+        return;
+    }
+    for (uint64_t i = 0; i < count.value(); ++i) {
+        ContentHash hash {};
+        Record record {};
+        if (!read_value(is, hash.h1) || !read_value(is, hash.h2) || !read_value(is, record.size)
+            || !read_value(is, record.timestamp) || !read_string(is, record.destination, MAX_DESTINATION_LENGTH)) {
+            spdlog::warn("Ignoring truncated content catalog: {0}", m_catalogFile.string());
+            m_records.clear();
+            m_sizes.clear();
+            return;
+        }
+        add(hash, std::move(record));
+    }
+}
+
+auto ContentCatalog::store() const -> void
+{
+    // the operation may have failed, or the file was removed as duplicate meanwhile
+    std::vector<const std::pair<const ContentHash, Record>*> records;
+    records.reserve(m_records.size());
+    for (const auto& item : m_records) {
+        if (item.second.pending && !fs::exists(m_outputDir / item.second.destination)) {
+            continue;
+        }
+        if (item.second.destination.size() <= MAX_DESTINATION_LENGTH) {
+            records.push_back(&item);
+        }
+    }
+
+    store_catalog_file(m_catalogFile, [&records](std::ostream& os) {
+        write_catalog_header(os, CONTENT_CATALOG_MAGIC, CONTENT_CATALOG_VERSION, records.size());
+        for (const auto* item : records) {
+            const auto& [hash, record] = *item;
+            write_value(os, hash.h1);
+            write_value(os, hash.h2);
+            write_value(os, record.size);
+            write_value(os, record.timestamp);
+            write_string(os, record.destination);
+        }
+    });
+}
+
+} // namespace mediacopier
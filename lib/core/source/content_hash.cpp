@@ -0,0 +1,239 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/content_hash.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+constexpr static const uint64_t C1 = 0x87c37b91114253d5ULL;
+constexpr static const uint64_t C2 = 0x4cf5812d5e2deb7fULL;
+
+static auto read_le64(const uint8_t* data) noexcept -> uint64_t
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        value |= uint64_t { data[i] } << (i * 8);
+    }
+    return value;
+}
+
+// first 32 bits of the fractional parts of the cube roots of the first 64 primes
+constexpr static const std::array<uint32_t, 64> K = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static auto read_be32(const uint8_t* data) noexcept -> uint32_t
+{
+    return uint32_t { data[0] } << 24 | uint32_t { data[1] } << 16 | uint32_t { data[2] } << 8 | uint32_t { data[3] };
+}
+
+static auto fmix64(uint64_t k) noexcept -> uint64_t
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+namespace mediacopier {
+
+auto Murmur3Hasher::update(std::span<const uint8_t> data) noexcept -> void
+{
+    m_length += data.size();
+
+    if (m_tailSize > 0) {
+        const auto count = std::min(m_tail.size() - m_tailSize, data.size());
+        std::memcpy(m_tail.data() + m_tailSize, data.data(), count);
+        m_tailSize += count;
+        data = data.subspan(count);
+        if (m_tailSize < m_tail.size()) {
+            return;
+        }
+        block(m_tail.data());
+        m_tailSize = 0;
+    }
+    for (; data.size() >= m_tail.size(); data = data.subspan(m_tail.size())) {
+        block(data.data());
+    }
+    std::memcpy(m_tail.data(), data.data(), data.size());
+    m_tailSize = data.size();
+}
+
+auto Murmur3Hasher::finish() noexcept -> ContentHash
+{
+    uint64_t k1 = 0, k2 = 0;
+    for (size_t i = m_tailSize; i > 8; --i) {
+        k2 |= uint64_t { m_tail[i - 1] } << ((i - 9) * 8);
+    }
+    for (size_t i = std::min<size_t>(m_tailSize, 8); i > 0; --i) {
+        k1 |= uint64_t { m_tail[i - 1] } << ((i - 1) * 8);
+    }
+    if (m_tailSize > 8) {
+        k2 *= C2;
+        k2 = std::rotl(k2, 33);
+        k2 *= C1;
+        m_h2 ^= k2;
+    }
+    if (m_tailSize > 0) {
+        k1 *= C1;
+        k1 = std::rotl(k1, 31);
+        k1 *= C2;
+        m_h1 ^= k1;
+    }
+
+    m_h1 ^= m_length;
+    m_h2 ^= m_length;
+    m_h1 += m_h2;
+    m_h2 += m_h1;
+    m_h1 = fmix64(m_h1);
+    m_h2 = fmix64(m_h2);
+    m_h1 += m_h2;
+    m_h2 += m_h1;
+    return { m_h1, m_h2 };
+}
+
+auto Murmur3Hasher::block(const uint8_t* data) noexcept -> void
+{
+    auto k1 = read_le64(data);
+    auto k2 = read_le64(data + 8);
+
+    k1 *= C1;
+    k1 = std::rotl(k1, 31);
+    k1 *= C2;
+    m_h1 ^= k1;
+    m_h1 = std::rotl(m_h1, 27);
+    m_h1 += m_h2;
+    m_h1 = m_h1 * 5 + 0x52dce729;
+
+    k2 *= C2;
+    k2 = std::rotl(k2, 33);
+    k2 *= C1;
+    m_h2 ^= k2;
+    m_h2 = std::rotl(m_h2, 31);
+    m_h2 += m_h1;
+    m_h2 = m_h2 * 5 + 0x38495ab5;
+}
+
+auto Sha256Hasher::update(std::span<const uint8_t> data) noexcept -> void
+{
+    m_length += data.size();
+
+    if (m_tailSize > 0) {
+        const auto count = std::min(m_tail.size() - m_tailSize, data.size());
+        std::memcpy(m_tail.data() + m_tailSize, data.data(), count);
+        m_tailSize += count;
+        data = data.subspan(count);
+        if (m_tailSize < m_tail.size()) {
+            return;
+        }
+        block(m_tail.data());
+        m_tailSize = 0;
+    }
+    for (; data.size() >= m_tail.size(); data = data.subspan(m_tail.size())) {
+        block(data.data());
+    }
+    std::memcpy(m_tail.data(), data.data(), data.size());
+    m_tailSize = data.size();
+}
+
+auto Sha256Hasher::finish() noexcept -> Sha256Digest
+{
+    // a single one bit, zeros up to 8 bytes before the block end and the length in bits
+    const auto bits = m_length * 8;
+    m_tail[m_tailSize++] = 0x80;
+    if (m_tailSize > m_tail.size() - 8) {
+        std::fill(m_tail.begin() + static_cast<ptrdiff_t>(m_tailSize), m_tail.end(), 0);
+        block(m_tail.data());
+        m_tailSize = 0;
+    }
+    std::fill(m_tail.begin() + static_cast<ptrdiff_t>(m_tailSize), m_tail.end() - 8, 0);
+    for (size_t i = 0; i < 8; ++i) {
+        m_tail[m_tail.size() - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+    block(m_tail.data());
+
+    Sha256Digest digest;
+    for (size_t i = 0; i < m_state.size(); ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            digest[i * 4 + j] = static_cast<uint8_t>(m_state[i] >> (24 - j * 8));
+        }
+    }
+    return digest;
+}
+
+auto Sha256Hasher::block(const uint8_t* data) noexcept -> void
+{
+    std::array<uint32_t, 64> w;
+    for (size_t i = 0; i < 16; ++i) {
+        w[i] = read_be32(data + i * 4);
+    }
+    for (size_t i = 16; i < 64; ++i) {
+        const auto s0 = std::rotr(w[i - 15], 7) ^ std::rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const auto s1 = std::rotr(w[i - 2], 17) ^ std::rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    auto [a, b, c, d, e, f, g, h] = m_state;
+    for (size_t i = 0; i < 64; ++i) {
+        const auto s1 = std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25);
+        const auto ch = (e & f) ^ (~e & g);
+        const auto t1 = h + s1 + ch + K[i] + w[i];
+        const auto s0 = std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22);
+        const auto maj = (a & b) ^ (a & c) ^ (b & c);
+        const auto t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+    m_state[5] += f;
+    m_state[6] += g;
+    m_state[7] += h;
+}
+
+auto to_hex(const Sha256Digest& digest) -> std::string
+{
+    constexpr static const char* digits = "0123456789abcdef";
+    std::string result;
+    result.reserve(digest.size() * 2);
+    for (const auto byte : digest) {
+        result.push_back(digits[byte >> 4]);
+        result.push_back(digits[byte & 0x0f]);
+    }
+    return result;
+}
+
+} // namespace mediacopier
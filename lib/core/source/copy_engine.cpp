@@ -0,0 +1,402 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/copy_engine.hpp>
+
+#include <mediacopier/error.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#endif
+
+namespace fs = std::filesystem;
+namespace mc = mediacopier;
+
+namespace {
+
+constexpr static const size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+#ifndef _WIN32
+#ifdef __linux__
+// the kernel copies at most about 2 GiB per call anyway
+constexpr static const size_t COPY_CHUNK_SIZE = 1024 * 1024 * 1024;
+#endif
+
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd) noexcept
+        : m_fd { fd }
+    {
+    }
+    ~FileDescriptor()
+    {
+        if (m_fd >= 0) {
+            ::close(m_fd);
+        }
+    }
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    FileDescriptor(FileDescriptor&&) = delete;
+    FileDescriptor& operator=(FileDescriptor&&) = delete;
+
+    auto get() const noexcept -> int { return m_fd; }
+    auto valid() const noexcept -> bool { return m_fd >= 0; }
+    auto close() noexcept -> bool
+    {
+        const auto result = ::close(m_fd);
+        m_fd = -1;
+        return result == 0;
+    }
+
+private:
+    int m_fd;
+};
+
+[[noreturn]] auto throw_error(const std::string& message, const fs::path& path, int error) -> void
+{
+    throw mc::FileOperationError { message + " " + path.string() + ": " + std::error_code { error, std::generic_category() }.message() };
+}
+
+#ifdef __linux__
+// errors of file systems (or kernels) that don't support the method
+auto is_unsupported(int error) noexcept -> bool
+{
+    return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == ENOTTY;
+}
+
+// the source ended early, the copy would be incomplete
+[[noreturn]] auto throw_truncated(const fs::path& source, uint64_t copied, uint64_t size) -> void
+{
+    throw mc::FileOperationError { "Failed to copy " + source.string() + ": only " + std::to_string(copied) + " of " + std::to_string(size) + " bytes could be read" };
+}
+
+/* Both return false if the method is not available for these files, this is
+ * only known before the first byte was written. The file offsets are used, so
+ * the next method starts where the last one left off. */
+
+auto copy_range(int input, int output, uint64_t size, const fs::path& source) -> bool
+{
+    for (uint64_t copied = 0; copied < size;) {
+        const auto count = ::copy_file_range(input, nullptr, output, nullptr, std::min<uint64_t>(size - copied, COPY_CHUNK_SIZE), 0);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (copied == 0 && is_unsupported(errno)) {
+                return false;
+            }
+            throw_error("Failed to copy", source, errno);
+        }
+        if (count == 0) {
+            if (copied == 0) {
+                return false; // some pseudo file systems report no data at all
+            }
+            throw_truncated(source, copied, size);
+        }
+        copied += static_cast<uint64_t>(count);
+    }
+    return true;
+}
+
+auto send_file(int input, int output, uint64_t size, const fs::path& source) -> bool
+{
+    for (uint64_t copied = 0; copied < size;) {
+        const auto count = ::sendfile(output, input, nullptr, std::min<uint64_t>(size - copied, COPY_CHUNK_SIZE));
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (copied == 0 && is_unsupported(errno)) {
+                return false;
+            }
+            throw_error("Failed to copy", source, errno);
+        }
+        if (count == 0) {
+            if (copied == 0) {
+                return false;
+            }
+            throw_truncated(source, copied, size);
+        }
+        copied += static_cast<uint64_t>(count);
+    }
+    return true;
+}
+#endif
+
+auto copy_buffered(int input, int output, const fs::path& source, const fs::path& destination, mc::Sha256Hasher* hasher = nullptr) -> void
+{
+    std::vector<uint8_t> buffer(COPY_BUFFER_SIZE);
+    while (true) {
+        const auto count = ::read(input, buffer.data(), buffer.size());
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_error("Failed to read", source, errno);
+        }
+        if (count == 0) {
+            return;
+        }
+        if (hasher != nullptr) {
+            hasher->update({ buffer.data(), static_cast<size_t>(count) });
+        }
+        for (ssize_t written = 0; written < count;) {
+            const auto result = ::write(output, buffer.data() + written, static_cast<size_t>(count - written));
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_error("Failed to write", destination, errno);
+            }
+            written += result;
+        }
+    }
+}
+
+// opens the files for `copy`, which returns the method it used
+template <typename Copy>
+auto copy_file_with(const fs::path& source, const fs::path& destination, Copy&& copy) -> mc::CopyMethod
+{
+    FileDescriptor input { ::open(source.c_str(), O_RDONLY | O_CLOEXEC) };
+    if (!input.valid()) {
+        throw_error("Failed to open", source, errno);
+    }
+    struct stat status { };
+    if (::fstat(input.get(), &status) != 0) {
+        throw_error("Failed to read the status of", source, errno);
+    }
+    if (!S_ISREG(status.st_mode)) {
+        throw mc::FileOperationError { "Not a regular file: " + source.string() };
+    }
+    // opening the destination truncates it, which must not hit the source
+    struct stat existing { };
+    if (::stat(destination.c_str(), &existing) == 0 && existing.st_dev == status.st_dev && existing.st_ino == status.st_ino) {
+        throw mc::FileOperationError { "Source and destination are the same file: " + source.string() };
+    }
+
+    const auto mode = status.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO);
+    FileDescriptor output { ::open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode) };
+    if (!output.valid()) {
+        throw_error("Failed to create", destination, errno);
+    }
+    if (::fchmod(output.get(), mode) != 0) {
+        spdlog::warn("Failed to set the permissions of {0}", destination.string());
+    }
+
+    const auto size = static_cast<uint64_t>(status.st_size);
+    const auto method = copy(input.get(), output.get(), size);
+    // delayed write errors (e.g. on network shares) show up here
+    if (!output.close()) {
+        throw_error("Failed to write", destination, errno);
+    }
+    spdlog::debug("Copied {0} using {1}", source.filename().string(), mc::to_string(method));
+    mc::copy_stats().record(method, size);
+    return method;
+}
+#else
+auto hash_stream(std::istream& input, const fs::path& path) -> mc::Sha256Digest
+{
+    mc::Sha256Hasher hasher;
+    std::vector<char> buffer(COPY_BUFFER_SIZE);
+    while (input.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || input.gcount() > 0) {
+        hasher.update({ reinterpret_cast<const uint8_t*>(buffer.data()), static_cast<size_t>(input.gcount()) });
+    }
+    if (input.bad()) {
+        throw mc::FileOperationError { "Failed to read " + path.string() };
+    }
+    return hasher.finish();
+}
+#endif
+
+} // namespace
+
+namespace mediacopier {
+
+auto to_string(CopyMethod method) -> std::string_view
+{
+    switch (method) {
+    case CopyMethod::Hardlink:
+        return "hard link";
+    case CopyMethod::Reflink:
+        return "reflink";
+    case CopyMethod::CopyFileRange:
+        return "copy_file_range";
+    case CopyMethod::Sendfile:
+        return "sendfile";
+    case CopyMethod::Buffered:
+        return "buffered copy";
+    case CopyMethod::Uring:
+        return "io_uring";
+    }
+    return "unknown";
+}
+
+auto CopyStats::record(CopyMethod method, uint64_t bytes) noexcept -> void
+{
+    auto& counter = m_counters.at(static_cast<size_t>(method));
+    counter.files.fetch_add(1, std::memory_order_relaxed);
+    counter.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+auto CopyStats::get(CopyMethod method) const noexcept -> Counter
+{
+    const auto& counter = m_counters.at(static_cast<size_t>(method));
+    return { counter.files.load(std::memory_order_relaxed), counter.bytes.load(std::memory_order_relaxed) };
+}
+
+auto CopyStats::reset() noexcept -> void
+{
+    for (auto& counter : m_counters) {
+        counter.files.store(0, std::memory_order_relaxed);
+        counter.bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+auto CopyStats::log() const -> void
+{
+    for (const auto method : { CopyMethod::Hardlink, CopyMethod::Reflink, CopyMethod::CopyFileRange, CopyMethod::Sendfile, CopyMethod::Buffered, CopyMethod::Uring }) {
+        const auto counter = get(method);
+        if (counter.files > 0) {
+            spdlog::info("Copied {0} files ({1} bytes) using {2}", counter.files, counter.bytes, to_string(method));
+        }
+    }
+}
+
+auto copy_stats() noexcept -> CopyStats&
+{
+    static CopyStats stats;
+    return stats;
+}
+
+auto fast_copy(const fs::path& source, const fs::path& destination) -> CopyMethod
+{
+#ifdef _WIN32
+    std::error_code err;
+    fs::copy_file(source, destination, fs::copy_options::overwrite_existing, err);
+    if (err) {
+        throw FileOperationError { "Failed to copy " + source.string() + ": " + err.message() };
+    }
+    const auto size = fs::file_size(destination, err);
+    spdlog::debug("Copied {0} using {1}", source.filename().string(), to_string(CopyMethod::Buffered));
+    copy_stats().record(CopyMethod::Buffered, size);
+    return CopyMethod::Buffered;
+#else
+    return copy_file_with(source, destination, [&](int input, int output, [[maybe_unused]] uint64_t size) {
+#ifdef __linux__
+        if (::ioctl(output, FICLONE, input) == 0) {
+            return CopyMethod::Reflink;
+        }
+        if (copy_range(input, output, size, source)) {
+            return CopyMethod::CopyFileRange;
+        }
+        if (send_file(input, output, size, source)) {
+            return CopyMethod::Sendfile;
+        }
+#endif
+        copy_buffered(input, output, source, destination);
+        return CopyMethod::Buffered;
+    });
+#endif
+}
+
+auto hashed_copy(const fs::path& source, const fs::path& destination) -> Sha256Digest
+{
+    Sha256Hasher hasher;
+#ifdef _WIN32
+    std::ifstream input { source, std::ios_base::in | std::ios_base::binary };
+    std::ofstream output { destination, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+    if (!input || !output) {
+        throw FileOperationError { "Failed to copy " + source.string() };
+    }
+    uint64_t size = 0;
+    std::vector<char> buffer(COPY_BUFFER_SIZE);
+    while (input.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || input.gcount() > 0) {
+        const auto count = static_cast<size_t>(input.gcount());
+        hasher.update({ reinterpret_cast<const uint8_t*>(buffer.data()), count });
+        output.write(buffer.data(), input.gcount());
+        size += count;
+    }
+    output.close();
+    if (input.bad() || !output) {
+        throw FileOperationError { "Failed to copy " + source.string() };
+    }
+    copy_stats().record(CopyMethod::Buffered, size);
+#else
+    copy_file_with(source, destination, [&](int input, int output, uint64_t /* size */) {
+        copy_buffered(input, output, source, destination, &hasher);
+        return CopyMethod::Buffered;
+    });
+#endif
+    return hasher.finish();
+}
+
+auto hash_stored_file(const fs::path& path) -> Sha256Digest
+{
+#ifdef _WIN32
+    std::ifstream input { path, std::ios_base::in | std::ios_base::binary };
+    if (!input) {
+        throw FileOperationError { "Failed to open " + path.string() };
+    }
+    return hash_stream(input, path);
+#else
+    FileDescriptor input { ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+    if (!input.valid()) {
+        throw_error("Failed to open", path, errno);
+    }
+#ifdef __linux__
+    // the data must be written before the cached pages can be dropped
+    if (::fdatasync(input.get()) != 0) {
+        throw_error("Failed to flush", path, errno);
+    }
+    ::posix_fadvise(input.get(), 0, 0, POSIX_FADV_DONTNEED);
+    ::posix_fadvise(input.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    Sha256Hasher hasher;
+    std::vector<uint8_t> buffer(COPY_BUFFER_SIZE);
+    while (true) {
+        const auto count = ::read(input.get(), buffer.data(), buffer.size());
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw_error("Failed to read", path, errno);
+        }
+        if (count == 0) {
+            return hasher.finish();
+        }
+        hasher.update({ buffer.data(), static_cast<size_t>(count) });
+    }
+#endif
+}
+
+} // namespace mediacopier
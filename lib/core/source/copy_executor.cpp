@@ -0,0 +1,482 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/copy_executor.hpp>
+
+#include <mediacopier/copy_engine.hpp>
+#include <mediacopier/copy_verifier.hpp>
+#include <mediacopier/error.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#ifdef HAS_LIBURING
+#include <fcntl.h>
+#include <liburing.h>
+#include <sys/stat.h>
+#endif
+
+constexpr static const size_t MAX_FALLBACK_THREADS = 8;
+
+namespace fs = std::filesystem;
+
+namespace mediacopier {
+
+class CopyExecutor::Backend {
+public:
+    virtual ~Backend() = default;
+    virtual auto submit(Job job) -> void = 0;
+    // moves finished copies to `completions`, blocks until there is at least one if `wait` is set
+    virtual auto reap(std::vector<Completion>& completions, bool wait) -> void = 0;
+    virtual auto inFlight() const -> size_t = 0;
+};
+
+} // namespace mediacopier
+
+namespace {
+
+namespace mc = mediacopier;
+
+using Job = mc::CopyExecutor::Job;
+using Completion = mc::CopyExecutor::Completion;
+
+auto remove_partial(const fs::path& path) -> void
+{
+    std::error_code err;
+    fs::remove(path, err);
+    if (err) {
+        spdlog::warn("Failed to remove the incomplete file: ({0}): {1}", path.string(), err.message());
+    }
+}
+
+class ThreadPoolBackend : public mc::CopyExecutor::Backend {
+public:
+    ThreadPoolBackend(size_t threads, mc::CopyVerifier* verifier)
+        : m_verifier { verifier }
+    {
+        for (size_t i = 0; i < threads; ++i) {
+            m_threads.emplace_back(&ThreadPoolBackend::run, this);
+        }
+    }
+    ~ThreadPoolBackend() override
+    {
+        {
+            std::lock_guard lock { m_mutex };
+            m_stopped = true;
+        }
+        m_submitted.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+    ThreadPoolBackend(const ThreadPoolBackend&) = delete;
+    ThreadPoolBackend& operator=(const ThreadPoolBackend&) = delete;
+    ThreadPoolBackend(ThreadPoolBackend&&) = delete;
+    ThreadPoolBackend& operator=(ThreadPoolBackend&&) = delete;
+
+    auto submit(Job job) -> void override
+    {
+        {
+            std::lock_guard lock { m_mutex };
+            m_jobs.push_back(std::move(job));
+            ++m_inFlight;
+        }
+        m_submitted.notify_one();
+    }
+    auto reap(std::vector<Completion>& completions, bool wait) -> void override
+    {
+        std::unique_lock lock { m_mutex };
+        if (wait) {
+            m_completed.wait(lock, [this]() { return !m_done.empty() || m_inFlight == 0; });
+        }
+        m_inFlight -= m_done.size();
+        std::move(m_done.begin(), m_done.end(), std::back_inserter(completions));
+        m_done.clear();
+    }
+    auto inFlight() const -> size_t override
+    {
+        std::lock_guard lock { m_mutex };
+        return m_inFlight;
+    }
+
+private:
+    auto run() -> void
+    {
+        while (true) {
+            std::unique_lock lock { m_mutex };
+            m_submitted.wait(lock, [this]() { return !m_jobs.empty() || m_stopped; });
+            if (m_jobs.empty()) {
+                return;
+            }
+            Completion completion { std::move(m_jobs.front()) };
+            m_jobs.pop_front();
+            lock.unlock();
+
+            try {
+                if (m_verifier != nullptr) {
+                    m_verifier->copy(completion.job.source, completion.job.destination);
+                } else {
+                    mc::fast_copy(completion.job.source, completion.job.destination);
+                }
+            } catch (...) {
+                completion.error = std::current_exception();
+                remove_partial(completion.job.destination);
+            }
+
+            lock.lock();
+            m_done.push_back(std::move(completion));
+            lock.unlock();
+            m_completed.notify_all();
+        }
+    }
+
+    mc::CopyVerifier* m_verifier;
+    bool m_stopped = false;
+    size_t m_inFlight = 0; // submitted and not reaped yet
+    std::deque<Job> m_jobs;
+    std::vector<Completion> m_done;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_submitted;
+    std::condition_variable m_completed;
+    std::vector<std::thread> m_threads;
+};
+
+#ifdef HAS_LIBURING
+/* Every slot owns a registered buffer and two direct descriptors (source and
+ * destination), so the linked requests can refer to the files before they are
+ * opened. A file is copied in stages: both opens with the first chunk, each
+ * further chunk, and finally both closes. The next stage is queued when all
+ * completions of the current one arrived. */
+class UringBackend : public mc::CopyExecutor::Backend {
+public:
+    UringBackend(size_t depth, size_t bufferSize)
+        : m_slots(depth)
+        , m_bufferSize { bufferSize }
+        , m_buffers { std::make_unique<uint8_t[]>(depth * bufferSize) }
+    {
+        // the first stage of every slot takes four entries
+        int ret = io_uring_queue_init(static_cast<unsigned>(depth * 4), &m_ring, 0);
+        if (ret < 0) {
+            throw std::system_error { -ret, std::generic_category(), "io_uring_queue_init" };
+        }
+        std::vector<iovec> buffers(depth);
+        for (size_t i = 0; i < depth; ++i) {
+            buffers[i] = { m_buffers.get() + i * bufferSize, bufferSize };
+        }
+        ret = io_uring_register_buffers(&m_ring, buffers.data(), static_cast<unsigned>(depth));
+        if (ret == 0) {
+            ret = io_uring_register_files_sparse(&m_ring, static_cast<unsigned>(depth * 2));
+        }
+        if (ret < 0) {
+            io_uring_queue_exit(&m_ring);
+            throw std::system_error { -ret, std::generic_category(), "io_uring_register" };
+        }
+    }
+    ~UringBackend() override
+    {
+        // the kernel may still write to the buffers
+        std::vector<Completion> discarded;
+        try {
+            while (m_busy > 0) {
+                reap(discarded, true);
+            }
+        } catch (const std::system_error& err) {
+            spdlog::error("Failed to wait for pending copies: {0}", err.what());
+        }
+        io_uring_queue_exit(&m_ring);
+    }
+    UringBackend(const UringBackend&) = delete;
+    UringBackend& operator=(const UringBackend&) = delete;
+    UringBackend(UringBackend&&) = delete;
+    UringBackend& operator=(UringBackend&&) = delete;
+
+    auto submit(Job job) -> void override
+    {
+        const auto index = static_cast<unsigned>(std::distance(m_slots.begin(),
+            std::find_if(m_slots.begin(), m_slots.end(), [](const Slot& slot) { return !slot.busy; })));
+        auto& slot = m_slots.at(index);
+        slot = Slot {};
+        slot.job = std::move(job);
+        slot.busy = true;
+        ++m_busy;
+
+        // the size decides about the number of chunks, so this is done synchronously
+        struct stat source { };
+        if (::stat(slot.job.source.c_str(), &source) != 0) {
+            slot.error = "Failed to open " + slot.job.source.string() + ": " + std::error_code { errno, std::generic_category() }.message();
+            finish(index);
+            return;
+        }
+        struct stat existing { };
+        if (!S_ISREG(source.st_mode)) {
+            slot.error = "Not a regular file: " + slot.job.source.string();
+        } else if (::stat(slot.job.destination.c_str(), &existing) == 0 && existing.st_dev == source.st_dev && existing.st_ino == source.st_ino) {
+            slot.error = "Source and destination are the same file: " + slot.job.source.string();
+        }
+        if (!slot.error.empty()) {
+            finish(index);
+            return;
+        }
+        slot.size = static_cast<uint64_t>(source.st_size);
+
+        auto* sqe = nextSqe();
+        io_uring_prep_openat_direct(sqe, AT_FDCWD, slot.job.source.c_str(), O_RDONLY, 0, index * 2);
+        io_uring_sqe_set_data64(sqe, index * 2);
+        io_uring_sqe_set_flags(sqe, IOSQE_IO_LINK);
+        sqe = nextSqe();
+        io_uring_prep_openat_direct(sqe, AT_FDCWD, slot.job.destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+            source.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO), index * 2 + 1);
+        io_uring_sqe_set_data64(sqe, index * 2);
+        slot.pending = 2;
+        if (slot.size > 0) {
+            io_uring_sqe_set_flags(sqe, IOSQE_IO_LINK);
+            queueTransfer(index);
+        }
+        io_uring_submit(&m_ring);
+    }
+    auto reap(std::vector<Completion>& completions, bool wait) -> void override
+    {
+        while (true) {
+            io_uring_cqe* cqe = nullptr;
+            while (io_uring_peek_cqe(&m_ring, &cqe) == 0) {
+                complete(cqe->user_data, cqe->res);
+                io_uring_cqe_seen(&m_ring, cqe);
+            }
+            io_uring_submit(&m_ring);
+            std::move(m_done.begin(), m_done.end(), std::back_inserter(completions));
+            m_done.clear();
+            if (!wait || !completions.empty() || m_busy == 0) {
+                return;
+            }
+            const int ret = io_uring_wait_cqe(&m_ring, &cqe);
+            if (ret < 0 && ret != -EINTR) {
+                throw std::system_error { -ret, std::generic_category(), "io_uring_wait_cqe" };
+            }
+        }
+    }
+    auto inFlight() const -> size_t override
+    {
+        return m_busy;
+    }
+
+private:
+    struct Slot {
+        Job job;
+        std::string error;
+        uint64_t size = 0;
+        uint64_t offset = 0;
+        unsigned chunk = 0;
+        unsigned pending = 0;
+        bool cancelled = false;
+        bool closing = false;
+        bool busy = false;
+    };
+
+    auto nextSqe() -> io_uring_sqe*
+    {
+        auto* sqe = io_uring_get_sqe(&m_ring);
+        if (sqe == nullptr) {
+            io_uring_submit(&m_ring);
+            sqe = io_uring_get_sqe(&m_ring);
+        }
+        return sqe;
+    }
+
+    // the lowest bit of the user data marks reads and writes, they must transfer the whole chunk
+    auto queueTransfer(unsigned index) -> void
+    {
+        auto& slot = m_slots.at(index);
+        auto* buffer = m_buffers.get() + index * m_bufferSize;
+        slot.chunk = static_cast<unsigned>(std::min<uint64_t>(slot.size - slot.offset, m_bufferSize));
+
+        auto* sqe = nextSqe();
+        io_uring_prep_read_fixed(sqe, static_cast<int>(index * 2), buffer, slot.chunk, slot.offset, static_cast<int>(index));
+        io_uring_sqe_set_data64(sqe, index * 2 + 1);
+        io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE | IOSQE_IO_LINK);
+        sqe = nextSqe();
+        io_uring_prep_write_fixed(sqe, static_cast<int>(index * 2 + 1), buffer, slot.chunk, slot.offset, static_cast<int>(index));
+        io_uring_sqe_set_data64(sqe, index * 2 + 1);
+        io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+
+        slot.offset += slot.chunk;
+        slot.pending += 2;
+    }
+
+    auto queueClose(unsigned index) -> void
+    {
+        auto& slot = m_slots.at(index);
+        for (unsigned file = index * 2; file <= index * 2 + 1; ++file) {
+            auto* sqe = nextSqe();
+            io_uring_prep_close_direct(sqe, file);
+            io_uring_sqe_set_data64(sqe, index * 2);
+        }
+        slot.closing = true;
+        slot.pending = 2;
+    }
+
+    auto complete(uint64_t data, int result) -> void
+    {
+        const auto index = static_cast<unsigned>(data / 2);
+        auto& slot = m_slots.at(index);
+        --slot.pending;
+        // requests behind a failed one in the chain are cancelled, the failed one tells the reason
+        if (result == -ECANCELED) {
+            slot.cancelled = true;
+        } else if (!slot.error.empty()) {
+            // keep the first error
+        } else if (result < 0) {
+            slot.error = "Failed to copy " + slot.job.source.string() + ": " + std::error_code { -result, std::generic_category() }.message();
+        } else if ((data & 1) != 0 && static_cast<unsigned>(result) != slot.chunk) {
+            slot.error = "Failed to copy " + slot.job.source.string() + ": incomplete transfer";
+        }
+        if (slot.pending > 0) {
+            return;
+        }
+        if (slot.closing) {
+            finish(index);
+        } else if (slot.error.empty() && !slot.cancelled && slot.offset < slot.size) {
+            queueTransfer(index);
+        } else {
+            queueClose(index);
+        }
+    }
+
+    auto finish(unsigned index) -> void
+    {
+        auto& slot = m_slots.at(index);
+        Completion completion { std::move(slot.job) };
+        if (slot.error.empty() && slot.cancelled) {
+            slot.error = "Copy of " + completion.job.source.string() + " was cancelled";
+        }
+        if (slot.error.empty()) {
+            mc::copy_stats().record(mc::CopyMethod::Uring, slot.size);
+        } else {
+            completion.error = std::make_exception_ptr(mc::FileOperationError { slot.error });
+            remove_partial(completion.job.destination);
+        }
+        m_done.push_back(std::move(completion));
+        slot.busy = false;
+        --m_busy;
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_busy = 0;
+    size_t m_bufferSize;
+    std::unique_ptr<uint8_t[]> m_buffers;
+    std::vector<Completion> m_done;
+    io_uring m_ring {};
+};
+#endif
+
+// the data of verified copies must pass through the hash, io_uring doesn't do that
+auto make_backend(size_t depth, mc::CopyVerifier* verifier) -> std::unique_ptr<mc::CopyExecutor::Backend>
+{
+#ifdef HAS_LIBURING
+    if (verifier == nullptr) {
+        try {
+            return std::make_unique<UringBackend>(depth, mc::CopyExecutor::BUFFER_SIZE);
+        } catch (const std::system_error& err) {
+            spdlog::debug("io_uring not available, fallback to thread pool: {0}", err.what());
+        }
+    }
+#endif
+    return std::make_unique<ThreadPoolBackend>(std::min(depth, MAX_FALLBACK_THREADS), verifier);
+}
+
+} // namespace
+
+namespace mediacopier {
+
+CopyExecutor::CopyExecutor(size_t depth, DeviceLimits limits, CopyVerifier* verifier)
+    : m_depth { std::max<size_t>(depth, 1) }
+    , m_backend { make_backend(m_depth, verifier) }
+    , m_scheduler { limits }
+{
+}
+
+CopyExecutor::~CopyExecutor() = default;
+
+auto CopyExecutor::submit(Job job) -> void
+{
+    std::error_code err;
+    fs::create_directories(job.destination.parent_path(), err);
+    if (err) {
+        const auto message = "Could not create parent path (" + job.destination.parent_path().string() + "): " + err.message();
+        m_completions.push_back({ std::move(job), std::make_exception_ptr(FileOperationError { message }) });
+        return;
+    }
+    // a missing source fails in the backend
+    const auto bytes = fs::file_size(job.source, err);
+    m_pending.push_back({ std::move(job), err ? 0 : bytes });
+    dispatch();
+    while (m_pending.size() + m_dispatched.size() > m_depth) {
+        collect(true);
+        dispatch();
+    }
+}
+
+auto CopyExecutor::poll() -> std::vector<Completion>
+{
+    collect(false);
+    dispatch();
+    return std::exchange(m_completions, {});
+}
+
+auto CopyExecutor::drain() -> std::vector<Completion>
+{
+    while (!m_pending.empty() || !m_dispatched.empty()) {
+        dispatch();
+        collect(true);
+    }
+    return std::exchange(m_completions, {});
+}
+
+auto CopyExecutor::dispatch() -> void
+{
+    for (auto it = m_pending.begin(); it != m_pending.end() && m_dispatched.size() < m_depth;) {
+        const auto ticket = m_scheduler.tryAcquire(it->job.source, it->job.destination, it->bytes);
+        if (!ticket.has_value()) {
+            ++it;
+            continue;
+        }
+        auto job = std::move(it->job);
+        it = m_pending.erase(it);
+        const auto id = m_nextId++;
+        m_dispatched.emplace(id, Dispatched { job.tag, ticket.value() });
+        job.tag = id;
+        m_backend->submit(std::move(job));
+    }
+}
+
+auto CopyExecutor::collect(bool wait) -> void
+{
+    std::vector<Completion> completions;
+    m_backend->reap(completions, wait);
+    for (auto& completion : completions) {
+        const auto dispatched = m_dispatched.extract(completion.job.tag);
+        m_scheduler.release(dispatched.mapped().ticket);
+        completion.job.tag = dispatched.mapped().tag;
+        m_completions.push_back(std::move(completion));
+    }
+}
+
+} // namespace mediacopier
@@ -0,0 +1,151 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/copy_verifier.hpp>
+
+#include <mediacopier/copy_engine.hpp>
+#include <mediacopier/error.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+constexpr static const size_t DIGEST_LENGTH = 64;
+
+// file names with a backslash or a line break are escaped like sha256sum does
+static auto manifest_line(const std::string& digest, const std::string& name) -> std::string
+{
+    std::string escaped;
+    for (const auto c : name) {
+        if (c == '\\') {
+            escaped += "\\\\";
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else if (c == '\r') {
+            escaped += "\\r";
+        } else {
+            escaped.push_back(c);
+        }
+    }
+    return (escaped.size() != name.size() ? "\\" : "") + digest + "  " + escaped;
+}
+
+// the line without its checksum, two lines with the same key are about the same file
+static auto manifest_key(const std::string& line) -> std::string
+{
+    const size_t start = line.starts_with('\\') ? 1 : 0;
+    if (line.size() < start + DIGEST_LENGTH) {
+        return line;
+    }
+    return line.substr(0, start) + line.substr(start + DIGEST_LENGTH);
+}
+
+namespace mediacopier {
+
+CopyVerifier::CopyVerifier(std::optional<fs::path> manifestDir)
+    : m_manifestDir { std::move(manifestDir) }
+{
+}
+
+auto CopyVerifier::copy(const fs::path& source, const fs::path& destination) -> void
+{
+    const auto expected = hashed_copy(source, destination); // may throw
+    if (hash_stored_file(destination) != expected) {
+        std::error_code err;
+        fs::remove(destination, err);
+        throw VerificationError { "Verification failed, the copy differs from the original: " + source.string() + " -> " + destination.string() };
+    }
+    spdlog::debug("Verified {0}: {1}", destination.filename().string(), to_hex(expected));
+    add(destination, expected);
+}
+
+auto CopyVerifier::record(const fs::path& path) -> void
+{
+    if (m_manifestDir.has_value()) {
+        add(path, hash_stored_file(path));
+    }
+}
+
+auto CopyVerifier::store() -> void
+{
+    std::lock_guard lock { m_mutex };
+    if (!m_manifestDir.has_value() || m_checksums.empty()) {
+        return;
+    }
+    std::vector<std::string> lines;
+    std::unordered_map<std::string, size_t> keys;
+    for (const auto& [path, digest] : m_checksums) {
+        std::error_code err;
+        if (!fs::exists(path, err)) {
+            continue; // removed as a duplicate in the meantime
+        }
+        // relative to the manifest, so `sha256sum -c` works from the destination directory
+        auto name = path.lexically_relative(m_manifestDir.value());
+        if (name.empty() || *name.begin() == "..") {
+            name = path;
+        }
+        auto line = manifest_line(to_hex(digest), name.generic_string());
+        const auto [item, inserted] = keys.try_emplace(manifest_key(line), lines.size());
+        if (inserted) {
+            lines.push_back(std::move(line));
+        } else {
+            lines[item->second] = std::move(line);
+        }
+    }
+
+    // the manifest is rewritten, so files imported again don't leave their old checksum behind
+    const auto manifestFile = m_manifestDir.value() / MANIFEST_NAME;
+    auto temporaryFile = manifestFile;
+    temporaryFile += ".tmp";
+    {
+        std::ifstream is { manifestFile, std::ios_base::in | std::ios_base::binary };
+        std::ofstream os { temporaryFile, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc };
+        for (std::string line; std::getline(is, line);) {
+            if (!line.empty() && !keys.contains(manifest_key(line))) {
+                os << line << '\n';
+            }
+        }
+        for (const auto& line : lines) {
+            os << line << '\n';
+        }
+        if (!os.flush()) {
+            spdlog::error("Could not write checksum manifest: {0}", temporaryFile.string());
+            return;
+        }
+    }
+    std::error_code err;
+    fs::rename(temporaryFile, manifestFile, err);
+    if (err) {
+        spdlog::error("Could not replace checksum manifest ({0}): {1}", manifestFile.string(), err.message());
+        fs::remove(temporaryFile, err);
+        return;
+    }
+    m_checksums.clear();
+}
+
+auto CopyVerifier::add(const fs::path& path, const Sha256Digest& digest) -> void
+{
+    if (m_manifestDir.has_value()) {
+        std::lock_guard lock { m_mutex };
+        m_checksums.emplace_back(path, digest);
+    }
+}
+
+} // namespace mediacopier
@@ -0,0 +1,191 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/device_scheduler.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+#ifdef __linux__
+#include <sys/statfs.h>
+#include <sys/sysmacros.h>
+#endif
+
+namespace fs = std::filesystem;
+namespace mc = mediacopier;
+
+namespace {
+
+#ifdef __linux__
+constexpr static const long NFS_SUPER_MAGIC = 0x6969;
+constexpr static const long SMB_SUPER_MAGIC = 0x517B;
+constexpr static const long CIFS_SUPER_MAGIC = 0xFF534D42;
+constexpr static const long SMB2_SUPER_MAGIC = 0xFE534D42;
+constexpr static const long FUSE_SUPER_MAGIC = 0x65735546; // sshfs and friends
+
+auto read_attribute(const fs::path& path) -> std::string
+{
+    std::ifstream input { path };
+    std::string value;
+    std::getline(input, value);
+    return value;
+}
+
+auto is_network(const fs::path& path) -> bool
+{
+    struct statfs status { };
+    if (::statfs(path.c_str(), &status) != 0) {
+        return false;
+    }
+    const auto type = static_cast<long>(status.f_type);
+    return type == NFS_SUPER_MAGIC || type == SMB_SUPER_MAGIC || type == CIFS_SUPER_MAGIC || type == SMB2_SUPER_MAGIC || type == FUSE_SUPER_MAGIC;
+}
+
+auto block_device_kind(uint64_t device) -> mc::DeviceScheduler::Kind
+{
+    using Kind = mc::DeviceScheduler::Kind;
+
+    std::error_code err;
+    const auto link = fs::path { "/sys/dev/block" } / (std::to_string(major(device)) + ":" + std::to_string(minor(device)));
+    auto disk = fs::canonical(link, err);
+    if (err) {
+        return Kind::Unknown;
+    }
+    // partitions don't have a queue, their disk is the parent directory
+    if (!fs::exists(disk / "queue", err)) {
+        disk = disk.parent_path();
+    }
+    if (read_attribute(disk / "removable") == "1" || read_attribute(disk / "device" / "type") == "SD") {
+        return Kind::Removable;
+    }
+    const auto rotational = read_attribute(disk / "queue" / "rotational");
+    if (rotational.empty()) {
+        return Kind::Unknown;
+    }
+    return rotational == "1" ? Kind::Rotational : Kind::SolidState;
+}
+#endif
+
+} // namespace
+
+namespace mediacopier {
+
+auto to_string(DeviceScheduler::Kind kind) -> std::string_view
+{
+    switch (kind) {
+    case DeviceScheduler::Kind::Rotational:
+        return "rotational disk";
+    case DeviceScheduler::Kind::Removable:
+        return "removable media";
+    case DeviceScheduler::Kind::SolidState:
+        return "solid state disk";
+    case DeviceScheduler::Kind::Network:
+        return "network share";
+    case DeviceScheduler::Kind::Unknown:
+        break;
+    }
+    return "unknown device";
+}
+
+DeviceScheduler::DeviceScheduler(DeviceLimits limits)
+    : m_limits { limits }
+{
+}
+
+auto DeviceScheduler::device(const fs::path& path) -> std::pair<const uint64_t, Device>&
+{
+    uint64_t id = 0;
+#ifndef _WIN32
+    struct stat status { };
+    auto existing = path;
+    while (::stat(existing.c_str(), &status) != 0 && existing.has_relative_path()) {
+        existing = existing.parent_path();
+    }
+    id = static_cast<uint64_t>(status.st_dev);
+#endif
+
+    auto [it, inserted] = m_devices.try_emplace(id);
+    if (!inserted) {
+        return *it;
+    }
+    auto& device = it->second;
+#ifdef __linux__
+    device.kind = is_network(existing) ? Kind::Network : block_device_kind(id);
+#endif
+    switch (device.kind) {
+    case Kind::Rotational:
+    case Kind::Removable:
+        device.limit = m_limits.rotational;
+        break;
+    case Kind::Network:
+        device.limit = m_limits.network;
+        break;
+    case Kind::SolidState:
+    case Kind::Unknown:
+        device.limit = m_limits.solidState;
+        break;
+    }
+    device.limit = std::max<size_t>(device.limit, 1);
+    spdlog::debug("Copying at most {0} files at the same time on {1} ({2})", device.limit, path.string(), to_string(device.kind));
+    return *it;
+}
+
+auto DeviceScheduler::kind(const fs::path& path) -> Kind
+{
+    return device(path).second.kind;
+}
+
+auto DeviceScheduler::tryAcquire(const fs::path& source, const fs::path& destination, uint64_t bytes) -> std::optional<Ticket>
+{
+    auto& [sourceId, sourceDevice] = device(source);
+    auto& [destinationId, destinationDevice] = device(destination);
+    if (m_inFlight > 0) {
+        if (sourceDevice.inFlight >= sourceDevice.limit || destinationDevice.inFlight >= destinationDevice.limit) {
+            return {};
+        }
+        if (m_inFlightBytes + bytes > m_limits.inFlightBytes) {
+            return {};
+        }
+    }
+    // a copy within one device takes a single slot
+    ++sourceDevice.inFlight;
+    if (destinationId != sourceId) {
+        ++destinationDevice.inFlight;
+    }
+    ++m_inFlight;
+    m_inFlightBytes += bytes;
+    return Ticket { sourceId, destinationId, bytes };
+}
+
+auto DeviceScheduler::release(const Ticket& ticket) -> void
+{
+    --m_devices.at(ticket.source).inFlight;
+    if (ticket.destination != ticket.source) {
+        --m_devices.at(ticket.destination).inFlight;
+    }
+    --m_inFlight;
+    m_inFlightBytes -= ticket.bytes;
+}
+
+} // namespace mediacopier
@@ -0,0 +1,323 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/directory_walker.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+constexpr static const size_t MAX_DEFAULT_THREADS = 8;
+
+#ifndef _WIN32
+enum class EntryType {
+    Directory,
+    RegularFile,
+    Other,
+};
+
+// d_type is delivered by getdents for free on most filesystems, stat is only needed for symlinks and DT_UNKNOWN
+static auto entry_type(int dirfd, const dirent* entry) noexcept -> EntryType
+{
+    struct stat st { };
+    switch (entry->d_type) {
+    case DT_DIR:
+        return EntryType::Directory;
+    case DT_REG:
+        return EntryType::RegularFile;
+    case DT_UNKNOWN:
+        if (fstatat(dirfd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            return EntryType::Other;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            return EntryType::Directory;
+        }
+        if (S_ISREG(st.st_mode)) {
+            return EntryType::RegularFile;
+        }
+        if (!S_ISLNK(st.st_mode)) {
+            return EntryType::Other;
+        }
+        [[fallthrough]];
+    case DT_LNK:
+        // symlinks to regular files are accepted, symlinks to directories are not followed
+        if (fstatat(dirfd, entry->d_name, &st, 0) == 0 && S_ISREG(st.st_mode)) {
+            return EntryType::RegularFile;
+        }
+        return EntryType::Other;
+    default:
+        return EntryType::Other;
+    }
+}
+
+static auto make_entry(fs::path path, const struct stat& st) -> mediacopier::DirectoryWalker::Entry
+{
+    const auto modified = std::chrono::seconds { st.st_mtim.tv_sec } + std::chrono::nanoseconds { st.st_mtim.tv_nsec };
+    return {
+        std::move(path),
+        static_cast<uintmax_t>(st.st_size),
+        static_cast<uint64_t>(st.st_dev),
+        static_cast<uint64_t>(st.st_ino),
+        std::chrono::system_clock::time_point { std::chrono::duration_cast<std::chrono::system_clock::duration>(modified) },
+    };
+}
+#else
+static auto make_entry(const fs::directory_entry& entry, std::error_code& err) -> mediacopier::DirectoryWalker::Entry
+{
+    return {
+        entry.path(),
+        entry.file_size(err),
+        0,
+        0,
+        std::chrono::file_clock::to_sys(entry.last_write_time(err)),
+    };
+}
+#endif
+
+namespace mediacopier {
+
+DirectoryWalker::DirectoryWalker(fs::path root, bool statFiles, size_t threads, size_t capacity)
+    : m_statFiles { statFiles }
+    , m_capacity { std::max<size_t>(capacity, 1) }
+{
+    // a root that can't be read is the caller's problem, errors below it are only logged while walking
+    fs::directory_iterator { root };
+
+    if (threads == 0) {
+        threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MAX_DEFAULT_THREADS);
+    }
+    m_queues = std::vector<WorkQueue>(threads);
+    m_pending = 1;
+    m_queued = 1;
+    m_queues.front().dirs.push_back(std::move(root));
+    for (size_t i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&DirectoryWalker::run, this, i);
+    }
+}
+
+DirectoryWalker::~DirectoryWalker()
+{
+    cancel();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+auto DirectoryWalker::status(fs::path path) -> std::optional<Entry>
+{
+#ifndef _WIN32
+    struct stat st { };
+    if (::stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return {};
+    }
+    return { make_entry(std::move(path), st) };
+#else
+    std::error_code err;
+    const fs::directory_entry entry { std::move(path), err };
+    if (err || !entry.is_regular_file(err)) {
+        return {};
+    }
+    return { make_entry(entry, err) };
+#endif
+}
+
+auto DirectoryWalker::next() -> std::optional<Entry>
+{
+    std::unique_lock lock { m_filesMutex };
+    m_filesNotEmpty.wait(lock, [this]() { return !m_files.empty() || m_done || m_cancelled.load(); });
+    if (m_files.empty() || m_cancelled.load()) {
+        return {};
+    }
+    auto file = std::move(m_files.front());
+    m_files.pop_front();
+    lock.unlock();
+    m_filesNotFull.notify_one();
+    return { std::move(file) };
+}
+
+auto DirectoryWalker::cancel() -> void
+{
+    m_cancelled.store(true);
+    {
+        std::lock_guard lock { m_idleMutex };
+    }
+    m_idleCondition.notify_all();
+    {
+        std::lock_guard lock { m_filesMutex };
+    }
+    m_filesNotEmpty.notify_all();
+    m_filesNotFull.notify_all();
+}
+
+auto DirectoryWalker::progress() const -> Progress
+{
+    return { m_filesFound.load(), m_bytesFound.load(), m_complete.load() };
+}
+
+auto DirectoryWalker::run(size_t index) -> void
+{
+    while (auto dir = acquire(index)) {
+        scan(dir.value(), index);
+        if (m_pending.fetch_sub(1) == 1) {
+            finish();
+        }
+    }
+}
+
+auto DirectoryWalker::acquire(size_t index) -> std::optional<fs::path>
+{
+    while (!m_cancelled.load()) {
+        // own queue is processed depth first, stealing happens from the other end
+        for (size_t i = 0; i < m_queues.size(); ++i) {
+            auto& queue = m_queues.at((index + i) % m_queues.size());
+            std::lock_guard lock { queue.mutex };
+            if (queue.dirs.empty()) {
+                continue;
+            }
+            fs::path dir;
+            if (i == 0) {
+                dir = std::move(queue.dirs.back());
+                queue.dirs.pop_back();
+            } else {
+                dir = std::move(queue.dirs.front());
+                queue.dirs.pop_front();
+            }
+            m_queued.fetch_sub(1);
+            return { std::move(dir) };
+        }
+        std::unique_lock lock { m_idleMutex };
+        m_idleCondition.wait(lock, [this]() {
+            return m_queued.load() > 0 || m_pending.load() == 0 || m_cancelled.load();
+        });
+        if (m_pending.load() == 0) {
+            break;
+        }
+    }
+    return {};
+}
+
+auto DirectoryWalker::scan(const fs::path& dir, size_t index) -> void
+{
+#ifndef _WIN32
+    const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        spdlog::warn("Could not open directory ({0}): {1}", dir.string(), std::strerror(errno));
+        return;
+    }
+    std::unique_ptr<DIR, int (*)(DIR*)> handle { ::fdopendir(fd), &::closedir };
+    if (!handle) {
+        spdlog::warn("Could not read directory ({0}): {1}", dir.string(), std::strerror(errno));
+        ::close(fd);
+        return;
+    }
+    const dirent* entry = nullptr;
+    struct stat st { };
+    while (!m_cancelled.load() && (entry = ::readdir(handle.get())) != nullptr) {
+        const std::string_view name { static_cast<const char*>(entry->d_name) };
+        if (name == "." || name == "..") {
+            continue;
+        }
+        switch (entry_type(fd, entry)) {
+        case EntryType::Directory:
+            pushDirectory(dir / name, index);
+            break;
+        case EntryType::RegularFile:
+            if (m_statFiles && fstatat(fd, entry->d_name, &st, 0) != 0) {
+                spdlog::warn("Could not read file status ({0}): {1}", (dir / name).string(), std::strerror(errno));
+                break;
+            }
+            if (!pushFile(m_statFiles ? make_entry(dir / name, st) : Entry { dir / name })) {
+                return;
+            }
+            break;
+        case EntryType::Other:
+            break;
+        }
+    }
+#else
+    std::error_code err;
+    for (const auto& entry : fs::directory_iterator(dir, err)) {
+        if (m_cancelled.load()) {
+            break;
+        }
+        if (entry.is_directory(err) && !entry.is_symlink(err)) {
+            pushDirectory(entry.path(), index);
+        } else if (entry.is_regular_file(err) && !pushFile(m_statFiles ? make_entry(entry, err) : Entry { entry.path() })) {
+            return;
+        }
+    }
+    if (err) {
+        spdlog::warn("Could not read directory ({0}): {1}", dir.string(), err.message());
+    }
+#endif
+}
+
+auto DirectoryWalker::pushDirectory(fs::path dir, size_t index) -> void
+{
+    m_pending.fetch_add(1);
+    m_queued.fetch_add(1);
+    {
+        auto& queue = m_queues.at(index);
+        std::lock_guard lock { queue.mutex };
+        queue.dirs.push_back(std::move(dir));
+    }
+    {
+        std::lock_guard lock { m_idleMutex };
+    }
+    m_idleCondition.notify_one();
+}
+
+auto DirectoryWalker::pushFile(Entry file) -> bool
+{
+    m_filesFound.fetch_add(1);
+    m_bytesFound.fetch_add(file.size);
+    std::unique_lock lock { m_filesMutex };
+    m_filesNotFull.wait(lock, [this]() { return m_files.size() < m_capacity || m_cancelled.load(); });
+    if (m_cancelled.load()) {
+        return false;
+    }
+    m_files.push_back(std::move(file));
+    lock.unlock();
+    m_filesNotEmpty.notify_one();
+    return true;
+}
+
+auto DirectoryWalker::finish() -> void
+{
+    m_complete.store(true);
+    {
+        std::lock_guard lock { m_filesMutex };
+        m_done = true;
+    }
+    m_filesNotEmpty.notify_all();
+    {
+        std::lock_guard lock { m_idleMutex };
+    }
+    m_idleCondition.notify_all();
+}
+
+} // namespace mediacopier
@@ -0,0 +1,179 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifdef __linux__
+
+#include <mediacopier/directory_watcher.hpp>
+
+#include <mediacopier/error.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+constexpr static const uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE
+    | IN_MODIFY | IN_ONLYDIR | IN_DONT_FOLLOW;
+constexpr static const size_t EVENT_BUFFER_SIZE = 64 * 1024;
+
+namespace mediacopier {
+
+DirectoryWatcher::DirectoryWatcher(fs::path root, std::chrono::milliseconds quietPeriod)
+    : m_fd { ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC) }
+    , m_root { std::move(root) }
+    , m_quietPeriod { quietPeriod }
+{
+    if (m_fd < 0) {
+        throw MediaCopierError { "Could not initialize inotify: " + std::string { std::strerror(errno) } };
+    }
+    addWatches(m_root, false);
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    ::close(m_fd);
+}
+
+auto DirectoryWatcher::poll(std::chrono::milliseconds timeout) -> std::vector<fs::path>
+{
+    auto now = Clock::now();
+    for (const auto& [path, touched] : m_pending) {
+        const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(touched + m_quietPeriod - now);
+        timeout = std::clamp(remaining, std::chrono::milliseconds::zero(), timeout);
+    }
+
+    pollfd pfd { m_fd, POLLIN, 0 };
+    const int ret = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    if (ret < 0 && errno != EINTR) {
+        throw MediaCopierError { "Could not poll inotify events: " + std::string { std::strerror(errno) } };
+    }
+    if (ret > 0) {
+        readEvents();
+    }
+
+    std::vector<fs::path> ready;
+    now = Clock::now();
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second >= m_quietPeriod) {
+            ready.push_back(it->first);
+            it = m_pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return ready;
+}
+
+auto DirectoryWatcher::addWatches(const fs::path& dir, bool reportFiles) -> void
+{
+    const int wd = ::inotify_add_watch(m_fd, dir.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        if (errno == ENOSPC) {
+            spdlog::warn("Could not watch directory ({0}): limit reached, see fs.inotify.max_user_watches", dir.string());
+        } else {
+            spdlog::warn("Could not watch directory ({0}): {1}", dir.string(), std::strerror(errno));
+        }
+        return;
+    }
+    m_watches[wd] = dir;
+
+    // the watch is in place before listing, so nothing created in between gets lost
+    std::error_code err;
+    for (const auto& entry : fs::directory_iterator(dir, err)) {
+        if (entry.is_symlink(err)) {
+            if (reportFiles && entry.is_regular_file(err)) {
+                m_pending.try_emplace(entry.path(), Clock::now());
+            }
+        } else if (entry.is_directory(err)) {
+            addWatches(entry.path(), reportFiles);
+        } else if (reportFiles && entry.is_regular_file(err)) {
+            m_pending.try_emplace(entry.path(), Clock::now());
+        }
+    }
+}
+
+auto DirectoryWatcher::removeWatches(const fs::path& dir) -> void
+{
+    const auto prefix = (dir / "").native();
+    for (auto it = m_watches.begin(); it != m_watches.end();) {
+        if (it->second == dir || it->second.native().starts_with(prefix)) {
+            ::inotify_rm_watch(m_fd, it->first);
+            it = m_watches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+auto DirectoryWatcher::readEvents() -> void
+{
+    alignas(inotify_event) std::array<char, EVENT_BUFFER_SIZE> buffer {};
+    while (true) {
+        const auto length = ::read(m_fd, buffer.data(), buffer.size());
+        if (length <= 0) {
+            break;
+        }
+        const auto now = Clock::now();
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if ((event->mask & IN_Q_OVERFLOW) != 0) {
+                spdlog::warn("Too many file system events, rescanning {0}", m_root.string());
+                addWatches(m_root, true);
+                continue;
+            }
+            if ((event->mask & IN_IGNORED) != 0) {
+                m_watches.erase(event->wd);
+                continue;
+            }
+            const auto watch = m_watches.find(event->wd);
+            if (watch == m_watches.end() || event->len == 0) {
+                continue;
+            }
+            const auto path = watch->second / static_cast<const char*>(event->name);
+
+            if ((event->mask & IN_ISDIR) != 0) {
+                if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+                    addWatches(path, true);
+                } else if ((event->mask & IN_MOVED_FROM) != 0) {
+                    removeWatches(path);
+                }
+            } else if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+                m_pending[path] = now;
+            } else if ((event->mask & IN_MODIFY) != 0) {
+                // still being written, restart the quiet period
+                if (auto it = m_pending.find(path); it != m_pending.end()) {
+                    it->second = now;
+                }
+            } else if ((event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+                m_pending.erase(path);
+            }
+        }
+    }
+}
+
+} // namespace mediacopier
+
+#endif
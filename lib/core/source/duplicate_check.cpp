@@ -16,90 +16,179 @@
 
 #include <mediacopier/duplicate_check.hpp>
 
+#include <mediacopier/file_source.hpp>
+
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace fs = std::filesystem;
+namespace mc = mediacopier;
 
-constexpr static const size_t BUFFER_SIZE = 64;
-constexpr static const size_t CHUNKS_MAX = 128;
+constexpr static const size_t COMPARE_BLOCK_SIZE = 1024 * 1024;
+constexpr static const size_t READ_BUFFER_SIZE = 64 * 1024;
 
 // as defined in https://en.wikipedia.org/wiki/JPEG_File_Interchange_Format
 constexpr static const std::array<uint8_t, 2> JPEG_SOS { 0xFF, 0xDA };
 constexpr static const std::array<uint8_t, 2> JPEG_SOI { 0xFF, 0xD8 };
 
-static auto seek_jpeg_data(std::ifstream* input) noexcept -> bool
-{
-    uint16_t s1 = 0, s2 = 0;
-    std::array<char, 2> buf {};
-
-    input->seekg(2, std::ios_base::beg);
-
-    while (input->good()) {
-        input->read(buf.data(), buf.size());
-        if (static_cast<unsigned char>(buf[0]) == JPEG_SOS[0]
-            && static_cast<unsigned char>(buf[1]) == JPEG_SOS[1]) {
-            return true;
+namespace {
+
+#ifndef _WIN32
+// read-only mapping of the beginning of a file, the kernel reads ahead while comparing
+class MappedFile {
+public:
+    MappedFile(const fs::path& path, uint64_t length)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        if (length > 0) {
+            void* data = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                ::madvise(data, length, MADV_SEQUENTIAL);
+                m_data = static_cast<const uint8_t*>(data);
+                m_length = length;
+            }
+        }
+        ::close(fd);
+    }
+    ~MappedFile()
+    {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<uint8_t*>(m_data), m_length);
         }
-        input->read(buf.data(), buf.size());
-        s1 = static_cast<unsigned char>(buf[0]);
-        s2 = static_cast<unsigned char>(buf[1]);
-
-        auto segment_length = (s1 << 8) | s2;
-        input->seekg(segment_length - 2, std::ios_base::cur);
     }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
 
-    return false;
-}
+    auto data() const noexcept -> const uint8_t* { return m_data; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_length = 0;
+};
 
-static auto prepare_input_stream(const fs::path& file) -> std::unique_ptr<std::ifstream>
+auto compare_payloads(const fs::path& file1, const mc::Payload& payload1, const fs::path& file2, const mc::Payload& payload2, uint64_t length) -> bool
 {
-    if (!fs::exists(file)) {
-        throw std::runtime_error(file.string() + " does not exist");
+    const MappedFile map1 { file1, payload1.offset + length };
+    const MappedFile map2 { file2, payload2.offset + length };
+    if (map1.data() == nullptr || map2.data() == nullptr) {
+        return false;
     }
-    auto input = std::make_unique<std::ifstream>(file, std::ios_base::in | std::ios_base::binary);
-
-    std::array<char, 2> magic {};
-    input->read(magic.data(), magic.size());
-
-    if (static_cast<unsigned char>(magic[0]) == JPEG_SOI[0]
-        && static_cast<unsigned char>(magic[1]) == JPEG_SOI[1]) { // is jpeg file
-        seek_jpeg_data(input.get());
+    // compared in blocks, so the remaining pages aren't touched once a difference is found
+    for (uint64_t pos = 0; pos < length; pos += COMPARE_BLOCK_SIZE) {
+        const auto count = static_cast<size_t>(std::min<uint64_t>(length - pos, COMPARE_BLOCK_SIZE));
+        if (std::memcmp(map1.data() + payload1.offset + pos, map2.data() + payload2.offset + pos, count) != 0) {
+            return false;
+        }
     }
-    return input;
+    return true;
 }
+#else
+auto compare_payloads(const fs::path& file1, const mc::Payload& payload1, const fs::path& file2, const mc::Payload& payload2, uint64_t length) -> bool
+{
+    std::ifstream input1 { file1, std::ios_base::in | std::ios_base::binary };
+    std::ifstream input2 { file2, std::ios_base::in | std::ios_base::binary };
+    input1.seekg(static_cast<std::streamoff>(payload1.offset));
+    input2.seekg(static_cast<std::streamoff>(payload2.offset));
+
+    std::vector<char> buf1(READ_BUFFER_SIZE);
+    std::vector<char> buf2(READ_BUFFER_SIZE);
+    for (uint64_t left = length; left > 0;) {
+        const auto count = static_cast<size_t>(std::min<uint64_t>(left, READ_BUFFER_SIZE));
+        input1.read(buf1.data(), static_cast<std::streamsize>(count));
+        input2.read(buf2.data(), static_cast<std::streamsize>(count));
+        if (!input1 || !input2 || std::memcmp(buf1.data(), buf2.data(), count) != 0) {
+            return false;
+        }
+        left -= count;
+    }
+    return true;
+}
+#endif
+
+} // namespace
 
 namespace mediacopier {
 
-auto is_duplicate(const fs::path& file1, const fs::path& file2) -> bool
+auto is_duplicate(const fs::path& file1, const fs::path& file2, uint64_t budget) -> bool
 {
-    const auto input1 = prepare_input_stream(file1);
-    const auto input2 = prepare_input_stream(file2);
+    const auto payload1 = locate_payload(file1);
+    if (!payload1.has_value()) {
+        throw std::runtime_error(file1.string() + " does not exist");
+    }
+    const auto payload2 = locate_payload(file2);
+    if (!payload2.has_value()) {
+        throw std::runtime_error(file2.string() + " does not exist");
+    }
 
-    std::vector<char> buf(BUFFER_SIZE, '\0');
+    // only the given number of bytes is compared, if both payloads are longer they count as equal
+    const auto length = std::min(payload1->size, budget);
+    if (length != std::min(payload2->size, budget)) {
+        return false;
+    }
+    if (length == 0) {
+        return true; // empty payloads can't be mapped
+    }
+    return compare_payloads(file1, payload1.value(), file2, payload2.value(), length);
+}
 
-    std::string chunk1, chunk2;
-    size_t chunks_left = CHUNKS_MAX;
+auto locate_payload(const fs::path& file) -> std::optional<Payload>
+{
+    if (!fs::exists(file)) {
+        return {};
+    }
+    FileSource source { file };
+    const auto size = source.size();
+    const auto magic = source.read(0, JPEG_SOI.size());
+    if (!std::equal(JPEG_SOI.begin(), JPEG_SOI.end(), magic.begin(), magic.end())) {
+        return { Payload { 0, size } };
+    }
 
-    while (chunks_left > 0) {
-        if (input1->eof() && input2->eof()) {
-            break;
-        } else if (!input1->good() || !input2->good()) {
-            return false;
+    // walks the segments up to the start of scan
+    uint64_t offset = JPEG_SOI.size();
+    while (true) {
+        const auto segment = source.read(offset, 4);
+        if (segment.empty()) {
+            return { Payload { 0, size } };
         }
-        input1->read(buf.data(), BUFFER_SIZE);
-        chunk1 = { buf.begin(), buf.begin() + input1->gcount() };
-
-        input2->read(buf.data(), BUFFER_SIZE);
-        chunk2 = { buf.begin(), buf.begin() + input2->gcount() };
+        offset += JPEG_SOS.size();
+        if (segment[0] == JPEG_SOS[0] && segment[1] == JPEG_SOS[1]) {
+            return { Payload { offset, size - offset } };
+        }
+        offset += (uint64_t { segment[2] } << 8) | segment[3];
+    }
+}
 
-        if (chunk1 != chunk2) {
-            return false;
+auto hash_payload(const fs::path& file, const Payload& payload) -> std::optional<ContentHash>
+{
+    std::ifstream input { file, std::ios_base::in | std::ios_base::binary };
+    input.seekg(static_cast<std::streamoff>(payload.offset));
+
+    Murmur3Hasher hasher;
+    std::vector<uint8_t> buf(READ_BUFFER_SIZE);
+    for (uint64_t left = payload.size; left > 0;) {
+        const auto count = static_cast<size_t>(std::min<uint64_t>(left, buf.size()));
+        input.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(count));
+        if (static_cast<size_t>(input.gcount()) != count) {
+            return {};
         }
-        --chunks_left;
+        hasher.update({ buf.data(), count });
+        left -= count;
     }
-    return true;
+    return { hasher.finish() };
 }
 
 } // namespace mediacopier
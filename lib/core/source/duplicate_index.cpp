@@ -0,0 +1,156 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/duplicate_index.hpp>
+
+#include <mediacopier/error.hpp>
+
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+namespace mediacopier {
+
+DuplicateIndex::DuplicateIndex(uint64_t compareBudget)
+    : m_compareBudget { compareBudget }
+{
+}
+
+auto DuplicateIndex::find(const fs::path& file) -> std::optional<fs::path>
+{
+    auto& current = record(file);
+    const auto bucket = m_sizes.find(current.payload.size);
+    if (bucket == m_sizes.end()) {
+        return {};
+    }
+    if (!hash(current)) {
+        throw MediaCopierError { "Unable to read " + file.string() };
+    }
+    for (const auto handle : bucket->second) {
+        auto& other = m_records.at(handle);
+        // files which are gone already (e.g. moved) are skipped
+        if (handle != current.handle && hash(other) && equal(current, other)) {
+            return { m_paths.path(handle) };
+        }
+    }
+    return {};
+}
+
+auto DuplicateIndex::add(const fs::path& file) -> void
+{
+    auto& current = record(file);
+    if (!current.added) {
+        current.added = true;
+        m_sizes[current.payload.size].push_back(current.handle);
+    }
+}
+
+auto DuplicateIndex::remove(const fs::path& file) -> void
+{
+    const auto handle = m_paths.find(file);
+    const auto item = handle.has_value() ? m_records.find(handle.value()) : m_records.end();
+    if (item == m_records.end()) {
+        return;
+    }
+    if (item->second.added) {
+        auto& bucket = m_sizes[item->second.payload.size];
+        bucket.erase(std::remove(bucket.begin(), bucket.end(), item->first), bucket.end());
+    }
+    m_records.erase(item);
+}
+
+auto DuplicateIndex::clear() -> void
+{
+    m_paths = {};
+    m_records.clear();
+    m_sizes.clear();
+}
+
+auto DuplicateIndex::same(const fs::path& file1, const fs::path& file2) -> bool
+{
+    auto& record1 = record(file1);
+    auto& record2 = record(file2);
+    if (record1.payload.size != record2.payload.size) {
+        return false;
+    }
+    if (!hash(record1) || !hash(record2)) {
+        throw MediaCopierError { "Unable to read " + file1.string() + " or " + file2.string() };
+    }
+    return equal(record1, record2);
+}
+
+auto DuplicateIndex::payloadSize(const fs::path& file) -> uint64_t
+{
+    return record(file).payload.size;
+}
+
+auto DuplicateIndex::payloadHash(const fs::path& file) -> ContentHash
+{
+    auto& current = record(file);
+    if (!hash(current)) {
+        throw MediaCopierError { "Unable to read " + file.string() };
+    }
+    return current.hash.value();
+}
+
+auto DuplicateIndex::knownHash(const fs::path& file) const -> std::optional<ContentHash>
+{
+    const auto handle = m_paths.find(file);
+    const auto item = handle.has_value() ? m_records.find(handle.value()) : m_records.end();
+    if (item == m_records.end()) {
+        return {};
+    }
+    return item->second.hash;
+}
+
+auto DuplicateIndex::record(const fs::path& file) -> Record&
+{
+    const auto handle = m_paths.intern(file);
+    auto item = m_records.find(handle);
+    if (item == m_records.end()) {
+        const auto payload = locate_payload(file);
+        if (!payload.has_value()) {
+            throw MediaCopierError { file.string() + " does not exist" };
+        }
+        item = m_records.emplace(handle, Record { handle, payload.value(), {} }).first;
+    }
+    return item->second;
+}
+
+auto DuplicateIndex::hash(Record& record) -> bool
+{
+    if (!record.hash.has_value()) {
+        record.hash = hash_payload(m_paths.path(record.handle), record.payload);
+    }
+    return record.hash.has_value();
+}
+
+auto DuplicateIndex::equal(Record& record1, Record& record2) -> bool
+{
+    if (record1.hash != record2.hash) {
+        return false;
+    }
+    if (m_compareBudget == 0 || record1.handle == record2.handle) {
+        return true;
+    }
+    try {
+        return is_duplicate(m_paths.path(record1.handle), m_paths.path(record2.handle), m_compareBudget);
+    } catch (const std::runtime_error&) {
+        return false; // removed since it was hashed
+    }
+}
+
+} // namespace mediacopier
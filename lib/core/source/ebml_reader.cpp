@@ -0,0 +1,253 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/ebml_reader.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <chrono>
+#include <format>
+#include <string_view>
+
+namespace {
+
+namespace mc = mediacopier;
+
+enum ElementId : uint32_t {
+    Ebml = 0x1A45DFA3,
+    Segment = 0x18538067,
+    Info = 0x1549A966,
+    DateUtc = 0x4461,
+    Cluster = 0x1F43B675,
+    Tags = 0x1254C367,
+    Tag = 0x7373,
+    Targets = 0x63C0,
+    TagTrackUid = 0x63C5,
+    TagEditionUid = 0x63C9,
+    TagChapterUid = 0x63C4,
+    TagAttachmentUid = 0x63C6,
+    SimpleTag = 0x67C8,
+    TagName = 0x45A3,
+    TagString = 0x4487,
+};
+
+constexpr static const std::string_view CREATION_TIME { "creation_time" };
+constexpr static const size_t MAX_ID_LENGTH = 4;
+constexpr static const size_t MAX_SIZE_LENGTH = 8;
+constexpr static const size_t MAX_STRING_SIZE = 256;
+
+struct Element {
+    uint32_t id = 0;
+    uint64_t offset = 0; // of the payload
+    uint64_t size = 0; // of the payload
+    bool unknownSize = false;
+    auto end() const noexcept -> uint64_t { return offset + size; }
+};
+
+// element ids keep their length marker, sizes don't
+auto read_element(mc::FileSource& source, uint64_t pos, uint64_t end) -> std::optional<Element>
+{
+    const auto data = source.read(pos, static_cast<size_t>(std::min<uint64_t>(MAX_ID_LENGTH + MAX_SIZE_LENGTH, end - pos)));
+    if (data.empty()) {
+        return {};
+    }
+    const size_t idLength = static_cast<size_t>(std::countl_zero(data[0])) + 1;
+    if (idLength > MAX_ID_LENGTH || idLength >= data.size()) {
+        return {};
+    }
+    const size_t sizeLength = static_cast<size_t>(std::countl_zero(data[idLength])) + 1;
+    if (sizeLength > MAX_SIZE_LENGTH || idLength + sizeLength > data.size()) {
+        return {};
+    }
+
+    Element element;
+    for (size_t i = 0; i < idLength; ++i) {
+        element.id = (element.id << 8) | data[i];
+    }
+    const uint64_t mask = (uint64_t { 1 } << (7 * sizeLength)) - 1;
+    element.size = data[idLength] & (0xFF >> sizeLength);
+    for (size_t i = 1; i < sizeLength; ++i) {
+        element.size = (element.size << 8) | data[idLength + i];
+    }
+    element.offset = pos + idLength + sizeLength;
+    // all ones is reserved for elements of unknown size (live recordings)
+    if (element.size == mask) {
+        element.unknownSize = true;
+        element.size = end - element.offset;
+    }
+    if (element.size > end - element.offset) {
+        return {};
+    }
+    return { element };
+}
+
+// calls `visit` for each element within [begin, end) until it returns false,
+// unknown sizes are only accepted where `visit` can deal with them
+template <typename Visitor>
+auto for_each_element(mc::FileSource& source, uint64_t begin, uint64_t end, Visitor&& visit) -> bool
+{
+    uint64_t pos = begin;
+    while (pos < end) {
+        const auto element = read_element(source, pos, end);
+        if (!element.has_value()) {
+            return false;
+        }
+        if (!visit(element.value())) {
+            return true;
+        }
+        if (element->unknownSize) {
+            return false;
+        }
+        pos = element->end();
+    }
+    return true;
+}
+
+auto read_string(mc::FileSource& source, const Element& element) -> std::optional<std::string_view>
+{
+    if (element.size > MAX_STRING_SIZE) {
+        return {};
+    }
+    const auto data = source.read(element.offset, static_cast<size_t>(element.size));
+    if (data.size() != element.size) {
+        return {};
+    }
+    const auto* begin = reinterpret_cast<const char*>(data.data());
+    return { std::string_view { begin, std::find(begin, begin + data.size(), '\0') } };
+}
+
+auto read_date(mc::FileSource& source, const Element& element, std::string& value) -> bool
+{
+    const auto data = source.read(element.offset, static_cast<size_t>(element.size));
+    if (element.size == 0 || element.size > 8 || data.size() != element.size) {
+        return false;
+    }
+    // signed nanoseconds since 2001-01-01
+    uint64_t raw = (data[0] & 0x80) != 0 ? ~uint64_t { 0 } : 0;
+    for (const auto byte : data) {
+        raw = (raw << 8) | byte;
+    }
+    using namespace std::chrono;
+    const auto timestamp = sys_days { year { 2001 } / January / 1 } + nanoseconds { static_cast<int64_t>(raw) };
+    const auto seconds = floor<std::chrono::seconds>(timestamp);
+    value = std::format("{:%FT%T}.{:06}Z", seconds, duration_cast<microseconds>(timestamp - seconds).count());
+    return true;
+}
+
+// only global tags, libav reports the others as stream or chapter metadata
+auto read_tag(mc::FileSource& source, const Element& tag, std::string& value) -> bool
+{
+    bool valid = true;
+    bool global = true;
+    std::optional<std::string_view> found;
+
+    const auto& visitTargets = [&](const Element& target) -> bool {
+        switch (target.id) {
+        case ElementId::TagTrackUid:
+        case ElementId::TagEditionUid:
+        case ElementId::TagChapterUid:
+        case ElementId::TagAttachmentUid:
+            global = false;
+            break;
+        default:
+            break;
+        }
+        return true;
+    };
+    const auto& visitTag = [&](const Element& child) -> bool {
+        if (child.id == ElementId::Targets) {
+            valid = for_each_element(source, child.offset, child.end(), visitTargets);
+        } else if (child.id == ElementId::SimpleTag) {
+            std::optional<std::string_view> name;
+            std::optional<std::string_view> text;
+            valid = for_each_element(source, child.offset, child.end(), [&](const Element& entry) -> bool {
+                if (entry.id == ElementId::TagName) {
+                    name = read_string(source, entry);
+                } else if (entry.id == ElementId::TagString) {
+                    text = read_string(source, entry);
+                }
+                return true;
+            });
+            const auto& equal = [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; };
+            if (name.has_value() && text.has_value() && std::ranges::equal(name.value(), CREATION_TIME, equal)) {
+                found = text;
+            }
+        }
+        return valid;
+    };
+    if (!for_each_element(source, tag.offset, tag.end(), visitTag) || !valid) {
+        return false;
+    }
+    if (global && found.has_value()) {
+        value = found.value();
+    }
+    return true;
+}
+
+} // namespace
+
+namespace mediacopier {
+
+auto read_matroska_creation_time(FileSource& source) -> std::optional<std::string>
+{
+    bool valid = true;
+    bool segmentFound = false;
+    std::string dateUtc;
+    std::string creationTime;
+
+    const auto& visitSegment = [&](const Element& child) -> bool {
+        switch (child.id) {
+        case ElementId::Info:
+            valid = for_each_element(source, child.offset, child.end(), [&](const Element& entry) -> bool {
+                if (entry.id == ElementId::DateUtc) {
+                    valid = read_date(source, entry, dateUtc);
+                }
+                return valid;
+            }) && valid;
+            return valid;
+        case ElementId::Tags:
+            valid = for_each_element(source, child.offset, child.end(), [&](const Element& entry) -> bool {
+                if (entry.id == ElementId::Tag) {
+                    valid = read_tag(source, entry, creationTime);
+                }
+                return valid;
+            }) && valid;
+            return valid;
+        case ElementId::Cluster:
+            return false; // everything else is media data
+        default:
+            return true;
+        }
+    };
+    const auto& visitFile = [&](const Element& element) -> bool {
+        if (element.id == ElementId::Segment) {
+            segmentFound = true;
+            valid = for_each_element(source, element.offset, element.end(), visitSegment) && valid;
+            return false;
+        }
+        return element.id == ElementId::Ebml;
+    };
+    if (!for_each_element(source, 0, source.size(), visitFile) || !valid || !segmentFound) {
+        return {};
+    }
+    if (creationTime.empty() && dateUtc.empty()) {
+        return {};
+    }
+    return { creationTime.empty() ? dateUtc : creationTime };
+}
+
+} // namespace mediacopier
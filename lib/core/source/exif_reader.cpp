@@ -0,0 +1,306 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/exif_reader.hpp>
+
+#include <algorithm>
+
+namespace {
+
+namespace mc = mediacopier;
+
+constexpr static const uint8_t JPEG_MARKER = 0xFF;
+constexpr static const uint8_t JPEG_SOI = 0xD8;
+constexpr static const uint8_t JPEG_EOI = 0xD9;
+constexpr static const uint8_t JPEG_SOS = 0xDA;
+constexpr static const uint8_t JPEG_APP1 = 0xE1;
+constexpr static const std::string_view EXIF_HEADER { "Exif\0\0", 6 };
+
+constexpr static const size_t IFD_ENTRY_SIZE = 12;
+
+enum TiffType : uint16_t {
+    Byte = 1,
+    Ascii = 2,
+    Short = 3,
+    Long = 4,
+    Ifd = 13,
+};
+
+enum Tag : uint16_t {
+    Orientation = 0x0112,
+    DateTime = 0x0132,
+    ExifIfdPointer = 0x8769,
+    DateTimeOriginal = 0x9003,
+    DateTimeDigitized = 0x9004,
+    OffsetTime = 0x9010,
+    OffsetTimeOriginal = 0x9011,
+    OffsetTimeDigitized = 0x9012,
+    SubSecTime = 0x9290,
+    SubSecTimeOriginal = 0x9291,
+    SubSecTimeDigitized = 0x9292,
+};
+
+constexpr static const std::array<uint16_t, 4> TIFF_MAGIC = {
+    42,
+    0x4F52, // olympus 'RO'
+    0x5352, // olympus 'RS'
+    0x55, // panasonic
+};
+
+class SpanSource {
+public:
+    explicit SpanSource(std::span<const uint8_t> data) noexcept
+        : m_data { data }
+    {
+    }
+    auto read(uint64_t offset, size_t length) const noexcept -> std::span<const uint8_t>
+    {
+        if (offset > m_data.size() || length > m_data.size() - offset) {
+            return {};
+        }
+        return m_data.subspan(static_cast<size_t>(offset), length);
+    }
+
+private:
+    std::span<const uint8_t> m_data;
+};
+
+// offsets within the tiff structure are relative to its header
+template <typename Source>
+class TiffReader {
+public:
+    TiffReader(Source& source, uint64_t base, bool littleEndian)
+        : m_source { source }
+        , m_base { base }
+        , m_littleEndian { littleEndian }
+    {
+    }
+    auto u16(std::span<const uint8_t> data, size_t pos) const noexcept -> uint16_t
+    {
+        const uint16_t a = data[pos];
+        const uint16_t b = data[pos + 1];
+        return static_cast<uint16_t>(m_littleEndian ? (b << 8) | a : (a << 8) | b);
+    }
+    auto u32(std::span<const uint8_t> data, size_t pos) const noexcept -> uint32_t
+    {
+        const uint32_t a = u16(data, pos);
+        const uint32_t b = u16(data, pos + 2);
+        return m_littleEndian ? (b << 16) | a : (a << 16) | b;
+    }
+    auto ascii(std::span<const uint8_t> entry) -> std::optional<std::string_view>
+    {
+        const size_t count = u32(entry, 4);
+        if (count == 0) {
+            return { std::string_view { "" } };
+        }
+        const auto value = count <= 4 ? entry.subspan(8, count) : m_source.read(m_base + u32(entry, 8), count);
+        if (value.size() != count) {
+            return {};
+        }
+        const auto* begin = reinterpret_cast<const char*>(value.data());
+        return { std::string_view { begin, std::find(begin, begin + count, '\0') } };
+    }
+    template <typename Visitor>
+    auto readIfd(uint32_t offset, Visitor&& visit) -> bool
+    {
+        const auto header = m_source.read(m_base + offset, 2);
+        if (header.size() != 2) {
+            return false;
+        }
+        const size_t count = u16(header, 0);
+        const auto entries = m_source.read(m_base + offset + 2, count * IFD_ENTRY_SIZE);
+        if (entries.size() != count * IFD_ENTRY_SIZE) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const auto entry = entries.subspan(i * IFD_ENTRY_SIZE, IFD_ENTRY_SIZE);
+            if (!visit(u16(entry, 0), u16(entry, 2), entry)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    Source& m_source;
+    uint64_t m_base;
+    bool m_littleEndian;
+};
+
+enum class Layout {
+    Tiff, // IFD0 followed by the exif IFD
+    ImageIfd, // IFD0 only
+    ExifIfd, // the first IFD is the exif IFD
+};
+
+template <typename Source>
+auto read_tags(Source& source, uint64_t base, mc::ExifTags& tags, Layout layout) -> bool
+{
+    const auto header = source.read(base, 8);
+    if (header.size() != 8) {
+        return false;
+    }
+    bool littleEndian = false;
+    if (header[0] == 'I' && header[1] == 'I') {
+        littleEndian = true;
+    } else if (header[0] != 'M' || header[1] != 'M') {
+        return false;
+    }
+    TiffReader<Source> tiff { source, base, littleEndian };
+    if (std::find(TIFF_MAGIC.begin(), TIFF_MAGIC.end(), tiff.u16(header, 2)) == TIFF_MAGIC.end()) {
+        return false;
+    }
+
+    uint32_t exifIfd = 0;
+
+    const auto& setAscii = [&tiff](std::string_view& value, std::span<const uint8_t> entry, uint16_t type) -> bool {
+        if (type != TiffType::Ascii) {
+            return false;
+        }
+        // the first occurrence wins
+        if (value.data() == nullptr) {
+            auto ascii = tiff.ascii(entry);
+            if (!ascii.has_value()) {
+                return false;
+            }
+            value = ascii.value();
+        }
+        return true;
+    };
+
+    const auto& visitIfd0 = [&](uint16_t tag, uint16_t type, std::span<const uint8_t> entry) -> bool {
+        switch (tag) {
+        case Tag::DateTime:
+            return setAscii(tags.dateTime[2], entry, type);
+        case Tag::Orientation:
+            if (type == TiffType::Short) {
+                tags.orientation = tiff.u16(entry, 8);
+            } else if (type == TiffType::Byte) {
+                tags.orientation = entry[8];
+            } else if (type == TiffType::Long) {
+                tags.orientation = static_cast<uint16_t>(std::min<uint32_t>(tiff.u32(entry, 8), UINT16_MAX));
+            } else {
+                return false;
+            }
+            return true;
+        case Tag::ExifIfdPointer:
+            if (type != TiffType::Long && type != TiffType::Ifd) {
+                return false;
+            }
+            exifIfd = tiff.u32(entry, 8);
+            return true;
+        default:
+            return true;
+        }
+    };
+
+    const auto& visitExifIfd = [&](uint16_t tag, uint16_t type, std::span<const uint8_t> entry) -> bool {
+        switch (tag) {
+        case Tag::DateTimeOriginal:
+            return setAscii(tags.dateTime[0], entry, type);
+        case Tag::DateTimeDigitized:
+            return setAscii(tags.dateTime[1], entry, type);
+        case Tag::SubSecTimeOriginal:
+            return setAscii(tags.subSec[0], entry, type);
+        case Tag::SubSecTimeDigitized:
+            return setAscii(tags.subSec[1], entry, type);
+        case Tag::SubSecTime:
+            return setAscii(tags.subSec[2], entry, type);
+        case Tag::OffsetTimeOriginal:
+            return setAscii(tags.offset[0], entry, type);
+        case Tag::OffsetTimeDigitized:
+            return setAscii(tags.offset[1], entry, type);
+        case Tag::OffsetTime:
+            return setAscii(tags.offset[2], entry, type);
+        default:
+            return true;
+        }
+    };
+
+    if (layout == Layout::ExifIfd) {
+        return tiff.readIfd(tiff.u32(header, 4), visitExifIfd);
+    }
+    if (!tiff.readIfd(tiff.u32(header, 4), visitIfd0)) {
+        return false;
+    }
+    return layout == Layout::ImageIfd || exifIfd == 0 || tiff.readIfd(exifIfd, visitExifIfd);
+}
+
+} // namespace
+
+namespace mediacopier {
+
+auto locate_jpeg_exif(std::span<const uint8_t> jpeg) noexcept -> std::optional<ExifLocation>
+{
+    if (jpeg.size() < 2 || jpeg[0] != JPEG_MARKER || jpeg[1] != JPEG_SOI) {
+        return {};
+    }
+    size_t pos = 2;
+    while (pos + 4 <= jpeg.size()) {
+        if (jpeg[pos] != JPEG_MARKER) {
+            return {};
+        }
+        const uint8_t marker = jpeg[pos + 1];
+        if (marker == JPEG_MARKER) {
+            ++pos; // fill byte
+            continue;
+        }
+        if (marker == JPEG_SOS || marker == JPEG_EOI) {
+            return { ExifLocation {} };
+        }
+        const size_t length = (static_cast<size_t>(jpeg[pos + 2]) << 8) | jpeg[pos + 3];
+        if (length < 2) {
+            return {};
+        }
+        if (marker == JPEG_APP1 && length >= 2 + EXIF_HEADER.size()) {
+            if (pos + 4 + EXIF_HEADER.size() > jpeg.size()) {
+                return {};
+            }
+            if (std::equal(EXIF_HEADER.begin(), EXIF_HEADER.end(), jpeg.begin() + static_cast<std::ptrdiff_t>(pos + 4),
+                    [](char a, uint8_t b) { return static_cast<uint8_t>(a) == b; })) {
+                return { ExifLocation { pos + 4 + EXIF_HEADER.size(), length - 2 - EXIF_HEADER.size() } };
+            }
+        }
+        pos += 2 + length;
+    }
+    return {};
+}
+
+auto read_exif_tags(std::span<const uint8_t> tiff) noexcept -> std::optional<ExifTags>
+{
+    SpanSource source { tiff };
+    ExifTags tags;
+    if (!read_tags(source, 0, tags, Layout::Tiff)) {
+        return {};
+    }
+    return { tags };
+}
+
+auto read_exif_tags(FileSource& source, uint64_t offset) -> std::optional<ExifTags>
+{
+    ExifTags tags;
+    if (!read_tags(source, offset, tags, Layout::Tiff)) {
+        return {};
+    }
+    return { tags };
+}
+
+auto read_exif_ifd_tags(FileSource& source, uint64_t offset, TiffIfd ifd, ExifTags& tags) -> bool
+{
+    return read_tags(source, offset, tags, ifd == TiffIfd::Image ? Layout::ImageIfd : Layout::ExifIfd);
+}
+
+} // namespace mediacopier
@@ -17,59 +17,333 @@
 #include <mediacopier/file_info_factory.hpp>
 
 #include <exiv2/exiv2.hpp>
+#include <mediacopier/ebml_reader.hpp>
 #include <mediacopier/error.hpp>
+#include <mediacopier/exif_reader.hpp>
 #include <mediacopier/file_info_image_jpeg.hpp>
 #include <mediacopier/file_info_video.hpp>
+#include <mediacopier/file_source.hpp>
+#include <mediacopier/isobmff_reader.hpp>
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string_view>
+#include <type_traits>
+
 namespace fs = std::filesystem;
 
-namespace mediacopier {
+using namespace std::string_view_literals;
 
-auto to_file_info_ptr(const fs::path& path) -> FileInfoPtr
+constexpr static const size_t HEADER_SIZE = 512;
+constexpr static const uint64_t RAF_JPEG_POINTER = 84;
+constexpr static const size_t MATROSKA_READ_LIMIT = 64 * 1024;
+
+namespace {
+
+namespace mc = mediacopier;
+
+struct Signature {
+    mc::FileType type;
+    size_t offset;
+    std::string_view magic;
+    size_t offset2 = 0;
+    std::string_view magic2 = {};
+};
+
+// first match wins, so more specific signatures have to come first
+constexpr static const std::array signatures = {
+    Signature { mc::FileType::Jpeg, 0, "\xFF\xD8\xFF"sv },
+    Signature { mc::FileType::Orf, 0, "IIRO"sv },
+    Signature { mc::FileType::Orf, 0, "IIRS"sv },
+    Signature { mc::FileType::Orf, 0, "MMOR"sv },
+    Signature { mc::FileType::Rw2, 0, "IIU\0"sv },
+    Signature { mc::FileType::Crw, 0, "II\x1A\0"sv, 6, "HEAPCCDR"sv },
+    Signature { mc::FileType::Tiff, 0, "II*\0"sv },
+    Signature { mc::FileType::Tiff, 0, "MM\0*"sv },
+    Signature { mc::FileType::Raf, 0, "FUJIFILMCCD-RAW"sv },
+    Signature { mc::FileType::Mrw, 0, "\0MRM"sv },
+    Signature { mc::FileType::Png, 0, "\x89PNG\r\n\x1A\n"sv },
+    Signature { mc::FileType::Webp, 0, "RIFF"sv, 8, "WEBP"sv },
+    Signature { mc::FileType::Psd, 0, "8BPS"sv },
+    Signature { mc::FileType::Jp2, 0, "\0\0\0\x0CjP  \r\n\x87\n"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "heic"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "heix"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "heim"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "heis"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "mif1"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "msf1"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "avif"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "avis"sv },
+    Signature { mc::FileType::Heif, 4, "ftyp"sv, 8, "crx "sv },
+    Signature { mc::FileType::Isobmff, 4, "ftyp"sv },
+    Signature { mc::FileType::QuickTime, 4, "moov"sv },
+    Signature { mc::FileType::QuickTime, 4, "mdat"sv },
+    Signature { mc::FileType::QuickTime, 4, "wide"sv },
+    Signature { mc::FileType::QuickTime, 4, "free"sv },
+    Signature { mc::FileType::QuickTime, 4, "skip"sv },
+    Signature { mc::FileType::QuickTime, 4, "pnot"sv },
+    Signature { mc::FileType::Matroska, 0, "\x1A\x45\xDF\xA3"sv },
+    Signature { mc::FileType::Avi, 0, "RIFF"sv, 8, "AVI "sv },
+    Signature { mc::FileType::Asf, 0, "\x30\x26\xB2\x75\x8E\x66\xCF\x11"sv },
+    Signature { mc::FileType::Flv, 0, "FLV\x01"sv },
+    Signature { mc::FileType::Ogg, 0, "OggS"sv },
+    Signature { mc::FileType::MpegPs, 0, "\0\0\x01\xBA"sv },
+    Signature { mc::FileType::MpegTs, 0, "\x47"sv, 188, "\x47"sv },
+    Signature { mc::FileType::M2ts, 4, "\x47"sv, 196, "\x47"sv },
+};
+
+auto matches(std::span<const uint8_t> header, size_t offset, std::string_view magic) noexcept -> bool
 {
-    FileInfoPtr result = nullptr;
+    if (offset + magic.size() > header.size()) {
+        return false;
+    }
+    return std::equal(magic.begin(), magic.end(), header.begin() + static_cast<std::ptrdiff_t>(offset),
+        [](char a, uint8_t b) { return static_cast<uint8_t>(a) == b; });
+}
 
+using Probed = std::expected<mc::FileInfo, mc::ProbeError>;
+
+auto unexpected(mc::ProbeError::Reason reason, std::string message) -> std::unexpected<mc::ProbeError>
+{
+    return std::unexpected { mc::ProbeError { reason, std::move(message) } };
+}
+
+template <typename Metadata>
+auto make_image_info(const fs::path& path, Metadata& metadata, bool isJpeg) -> Probed
+{
+    const auto timestamp = mc::FileInfoImage::readTimestamp(metadata);
+    if (!timestamp.has_value()) {
+        return std::unexpected { timestamp.error() };
+    }
+
+    if (isJpeg) {
+        const auto orientation = mc::FileInfoImageJpeg::readOrientation(metadata);
+        if (orientation.has_value()) {
+            return mc::FileInfo { std::in_place_type<mc::FileInfoImageJpeg>, path, timestamp.value(), orientation.value() };
+        }
+        spdlog::warn("Error reading jpeg metadata {0}: {1}", path.string(), orientation.error().message);
+    }
+
+    return mc::FileInfo { std::in_place_type<mc::FileInfoImage>, path, timestamp.value() };
+}
+
+auto probe_image(const fs::path& path) -> Probed
+{
+    // exiv2 reports errors by throwing, the native readers above avoid getting here for most files
     try {
         auto image = Exiv2::ImageFactory::open(Exiv2::ImageFactory::createIo(path, true));
 
         if (image.get() != nullptr && image->imageType() != Exiv2::ImageType::none && image->supportsMetadata(Exiv2::MetadataId::mdExif)) {
-
             image->readMetadata();
-
-            if (image->mimeType() == "image/jpeg") {
-                try {
-                    result = std::make_shared<FileInfoImageJpeg>(path, image->exifData());
-                } catch (const FileInfoImageJpegError& err) {
-                    spdlog::warn("Error reading jpeg metadata {0}: {1}", path.string(), err.what());
-                } catch (const FileInfoError& err) {
-                    // ignore, will be reported anyway when file is parsed as 'FileInfoImage'
-                }
-            }
-
-            if (result == nullptr) {
-                try {
-                    result = std::make_shared<FileInfoImage>(path, image->exifData());
-                } catch (const FileInfoError& err) {
-                    spdlog::warn("Couldn't find image metadata in {0}: {1}", path.string(), err.what());
-                }
-            }
+            return make_image_info(path, image->exifData(), image->mimeType() == "image/jpeg");
         }
 
     } catch (const Exiv2::Error& err) {
-        spdlog::warn("Is no image file: {0}", err.what());
+        return unexpected(mc::ProbeError::Reason::InvalidMetadata, std::string { "Is no image file: " } + err.what());
     }
 
-    if (result == nullptr) {
-        try {
-            result = std::make_shared<FileInfoVideo>(path);
-        } catch (const FileInfoError& err) {
-            spdlog::warn("Couldn't find video metadata in {0}: {1}", path.string(), err.what());
+    return unexpected(mc::ProbeError::Reason::UnknownType, "Image format without exif support");
+}
+
+// only the exif segment is parsed, exiv2 is used for anything the native reader can't handle
+auto probe_jpeg(const fs::path& path, std::span<const uint8_t> header) -> Probed
+{
+    const auto location = mc::locate_jpeg_exif(header);
+    if (!location.has_value()) {
+        return probe_image(path);
+    }
+    if (location->size == 0) {
+        // the image data starts without an exif segment, exiv2 wouldn't find anything either
+        return unexpected(mc::ProbeError::Reason::NoMetadata, "No date information found");
+    }
+    mc::FileSource source { path, header };
+    const auto segment = source.read(location->offset, location->size);
+    const auto tags = segment.size() == location->size ? mc::read_exif_tags(segment) : std::nullopt;
+    if (!tags.has_value()) {
+        spdlog::debug("Unsupported exif data, fallback to exiv2: {0}", path.string());
+        return probe_image(path);
+    }
+    return make_image_info(path, tags.value(), true);
+}
+
+// tiff based raw formats keep the interesting tags close to the beginning, no need to read more
+auto probe_raw(const fs::path& path, mc::FileType type, std::span<const uint8_t> header) -> Probed
+{
+    mc::FileSource source { path, header };
+    uint64_t offset = 0;
+
+    if (type == mc::FileType::Raf) {
+        // fuji raw files embed a jpeg preview which carries the exif data
+        const auto pointer = source.read(RAF_JPEG_POINTER, 4);
+        if (pointer.size() != 4) {
+            return probe_image(path);
+        }
+        const uint64_t jpeg = (uint64_t { pointer[0] } << 24) | (uint64_t { pointer[1] } << 16) | (uint64_t { pointer[2] } << 8) | pointer[3];
+        const auto location = mc::locate_jpeg_exif(source.read(jpeg, mc::FileSource::BLOCK_SIZE));
+        if (!location.has_value() || location->size == 0) {
+            return probe_image(path);
         }
+        offset = jpeg + location->offset;
+    }
+
+    // some formats keep the dates in places only exiv2 knows about (e.g. rw2 previews)
+    const auto tags = mc::read_exif_tags(source, offset);
+    if (!tags.has_value() || std::ranges::all_of(tags->dateTime, [](auto value) { return value.data() == nullptr; })) {
+        spdlog::debug("Unsupported raw file, fallback to exiv2: {0}", path.string());
+        return probe_image(path);
+    }
+    return make_image_info(path, tags.value(), false);
+}
+
+// heic, avif and cr3 files keep their exif data in 'meta' items or 'moov' boxes
+auto probe_heif(const fs::path& path, std::span<const uint8_t> header) -> Probed
+{
+    mc::FileSource source { path, header };
+    const auto tags = mc::read_isobmff_exif_tags(source);
+    if (!tags.has_value() || std::ranges::all_of(tags->dateTime, [](auto value) { return value.data() == nullptr; })) {
+        spdlog::debug("Unsupported heif file, fallback to exiv2: {0}", path.string());
+        return probe_image(path);
+    }
+    return make_image_info(path, tags.value(), false);
+}
+
+auto make_video_info(const fs::path& path, const std::expected<mc::Timestamp, mc::ProbeError>& timestamp) -> Probed
+{
+    if (!timestamp.has_value()) {
+        return std::unexpected { timestamp.error() };
     }
+    return mc::FileInfo { std::in_place_type<mc::FileInfoVideo>, path, timestamp.value() };
+}
 
-    return result;
+auto probe_video(const fs::path& path) -> Probed
+{
+    return make_video_info(path, mc::FileInfoVideo::readTimestamp(path));
+}
+
+auto make_video_info(const fs::path& path, const std::optional<std::string>& timestamp) -> Probed
+{
+    if (!timestamp.has_value()) {
+        spdlog::debug("Unsupported video file, fallback to libav: {0}", path.string());
+        return probe_video(path);
+    }
+    return make_video_info(path, mc::FileInfoVideo::parseTimestamp(timestamp.value()));
+}
+
+// mp4 and quicktime files are walked box by box, libav would probe the streams as well
+auto probe_isobmff(const fs::path& path, std::span<const uint8_t> header) -> Probed
+{
+    mc::FileSource source { path, header };
+    return make_video_info(path, mc::read_isobmff_creation_time(source));
+}
+
+auto probe_matroska(const fs::path& path, std::span<const uint8_t> header) -> Probed
+{
+    mc::FileSource source { path, header, MATROSKA_READ_LIMIT };
+    return make_video_info(path, mc::read_matroska_creation_time(source));
+}
+
+auto read_header(const fs::path& path, std::array<uint8_t, HEADER_SIZE>& header) -> std::span<const uint8_t>
+{
+    std::ifstream input { path, std::ios_base::in | std::ios_base::binary };
+    input.read(reinterpret_cast<char*>(header.data()), header.size());
+    return { header.data(), static_cast<size_t>(input.gcount()) };
+}
+
+} // namespace
+
+namespace mediacopier {
+
+auto detect_file_type(std::span<const uint8_t> header) noexcept -> FileType
+{
+    for (const auto& signature : signatures) {
+        if (matches(header, signature.offset, signature.magic)
+            && matches(header, signature.offset2, signature.magic2)) {
+            return signature.type;
+        }
+    }
+    return FileType::Unknown;
+}
+
+auto is_image_type(FileType type) noexcept -> bool
+{
+    return type >= FileType::Jpeg && type <= FileType::Heif;
+}
+
+auto probe(const fs::path& path, std::span<const uint8_t> header) -> std::expected<FileInfo, ProbeError>
+{
+    const auto type = detect_file_type(header);
+
+    switch (type) {
+    case FileType::Unknown:
+        return unexpected(ProbeError::Reason::UnknownType, "Unknown file type");
+    case FileType::Jpeg:
+        return probe_jpeg(path, header);
+    case FileType::Tiff:
+    case FileType::Orf:
+    case FileType::Rw2:
+    case FileType::Raf:
+        return probe_raw(path, type, header);
+    case FileType::Heif:
+        return probe_heif(path, header);
+    case FileType::Isobmff:
+    case FileType::QuickTime:
+        return probe_isobmff(path, header);
+    case FileType::Matroska:
+        return probe_matroska(path, header);
+    default:
+        break;
+    }
+    if (is_image_type(type)) {
+        return probe_image(path);
+    }
+    return probe_video(path);
+}
+
+auto probe(const fs::path& path) -> std::expected<FileInfo, ProbeError>
+{
+    std::array<uint8_t, HEADER_SIZE> header {};
+    return probe(path, read_header(path, header));
+}
+
+auto to_file_info(const fs::path& path, std::span<const uint8_t> header) -> std::optional<FileInfo>
+{
+    auto result = probe(path, header);
+    if (!result.has_value()) {
+        if (result.error().reason == ProbeError::Reason::UnknownType) {
+            spdlog::debug("{0}: {1}", result.error().message, path.string());
+        } else {
+            spdlog::warn("Couldn't find metadata in {0}: {1}", path.string(), result.error().message);
+        }
+        return {};
+    }
+    return { std::move(result.value()) };
+}
+
+auto to_file_info(const fs::path& path) -> std::optional<FileInfo>
+{
+    std::array<uint8_t, HEADER_SIZE> header {};
+    return to_file_info(path, read_header(path, header));
+}
+
+auto to_file_info_ptr(const fs::path& path, std::span<const uint8_t> header) -> FileInfoPtr
+{
+    auto file = to_file_info(path, header);
+    if (!file.has_value()) {
+        return nullptr;
+    }
+    return std::visit([](auto&& info) -> FileInfoPtr {
+        return std::make_shared<std::remove_cvref_t<decltype(info)>>(std::move(info));
+    },
+        std::move(file.value()));
+}
+
+auto to_file_info_ptr(const fs::path& path) -> FileInfoPtr
+{
+    std::array<uint8_t, HEADER_SIZE> header {};
+    return to_file_info_ptr(path, read_header(path, header));
 }
 
 } // namespace mediacopier
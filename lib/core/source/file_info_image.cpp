@@ -18,9 +18,12 @@
 
 #include <mediacopier/abstract_operation.hpp>
 #include <mediacopier/error.hpp>
+#include <mediacopier/timestamp_parser.hpp>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <sstream>
 
 /* 'original' refers to the moment the picture was taken (shutter pressed),
  * 'digitized' is the moment where the picture was scanned (should be the same for digital cams),
@@ -44,58 +47,131 @@ static constexpr const std::array<std::string_view, 3> keysOffset = {
     "Exif.Photo.OffsetTime",
 };
 
-namespace mediacopier {
+namespace {
 
-FileInfoImage::FileInfoImage(std::filesystem::path path, Exiv2::ExifData& exif)
-    : AbstractFileInfo { std::move(path) }
+namespace mc = mediacopier;
+
+// chrono based parsing for anything the fixed layout parser doesn't accept
+auto parse_timestamp(std::string_view dateTime, std::string_view subSec) -> std::expected<std::chrono::system_clock::time_point, mc::ProbeError>
+{
+    std::stringstream timestamp;
+    timestamp << dateTime;
+
+    if (subSec.size() > 0) {
+        timestamp << "." << subSec;
+    }
+    if (timestamp.str().size() < 1) {
+        return std::unexpected { mc::ProbeError { mc::ProbeError::Reason::NoMetadata, "No date information found" } };
+    }
+
+    std::chrono::system_clock::time_point result;
+    timestamp >> std::chrono::parse("%Y:%m:%d %T", result);
+    if (timestamp.fail()) {
+        return std::unexpected { mc::ProbeError { mc::ProbeError::Reason::InvalidMetadata, "Invalid date info found" } };
+    }
+    return { result };
+}
+
+auto parse_offset(std::string_view offset) -> std::chrono::minutes
 {
-    std::string key, value;
     int hours = 0, minutes = 0;
     char colon = 0; // used for parsing timezone offset without scanning for separator
 
-    size_t i = keysDateTime.size();
-    for (size_t j = 0; j < keysDateTime.size(); ++j) {
-        key = keysDateTime.at(j);
-        if (exif.findKey(Exiv2::ExifKey { key }) != exif.end()) {
-            i = j;
-            break;
-        }
-    }
-    if (i == keysDateTime.size()) {
-        throw FileInfoError { "No date information found" };
+    std::stringstream timestamp { std::string { offset } };
+    timestamp >> hours >> colon >> minutes;
+    if (hours < 0) {
+        minutes *= -1;
     }
+    return std::chrono::hours(hours) + std::chrono::minutes(minutes);
+}
 
-    std::stringstream timestamp;
-    value = exif[key].toString();
-    timestamp << value;
-
-    key = keysSubSec.at(i);
-    if (exif.findKey(Exiv2::ExifKey { key }) != exif.end()) {
-        value = exif[key].toString();
-        if (value.size() > 0) {
-            timestamp << "." << value;
-        }
+// keeps the exiv2 values alive while they are referenced as tags
+class ExifValues {
+public:
+    explicit ExifValues(Exiv2::ExifData& exif)
+    {
+        const auto& read = [&exif](const auto& keys, auto& values, auto& tags) {
+            for (size_t i = 0; i < keys.size(); ++i) {
+                const std::string key { keys.at(i) };
+                if (exif.findKey(Exiv2::ExifKey { key }) != exif.end()) {
+                    values.at(i) = exif[key].toString();
+                    tags.at(i) = values.at(i);
+                }
+            }
+        };
+        read(keysDateTime, m_dateTime, tags.dateTime);
+        read(keysSubSec, m_subSec, tags.subSec);
+        read(keysOffset, m_offset, tags.offset);
     }
-    if (timestamp.str().size() < 1) {
-        throw FileInfoError { "No date information found" };
+    ExifValues(const ExifValues&) = delete;
+    ExifValues& operator=(const ExifValues&) = delete;
+    ExifValues(ExifValues&&) = delete;
+    ExifValues& operator=(ExifValues&&) = delete;
+    ~ExifValues() = default;
+
+    mediacopier::ExifTags tags;
+
+private:
+    std::array<std::string, 3> m_dateTime;
+    std::array<std::string, 3> m_subSec;
+    std::array<std::string, 3> m_offset;
+};
+
+} // namespace
+
+namespace mediacopier {
+
+FileInfoImage::FileInfoImage(std::filesystem::path path, Exiv2::ExifData& exif)
+    : FileInfoImage { std::move(path), ExifValues { exif }.tags }
+{
+}
+
+FileInfoImage::FileInfoImage(std::filesystem::path path, const ExifTags& tags)
+    : AbstractFileInfo { std::move(path) }
+{
+    const auto timestamp = readTimestamp(tags);
+    if (!timestamp.has_value()) {
+        throw FileInfoError { timestamp.error().message };
     }
+    m_timestamp = timestamp->local;
+    m_offset = timestamp->offset;
+}
 
-    timestamp >> std::chrono::parse("%Y:%m:%d %T", m_timestamp);
-    if (timestamp.fail()) {
-        throw FileInfoError { "Invalid date info found" };
+FileInfoImage::FileInfoImage(std::filesystem::path path, const Timestamp& timestamp) noexcept
+    : AbstractFileInfo { std::move(path), timestamp }
+{
+}
+
+auto FileInfoImage::readTimestamp(Exiv2::ExifData& exif) -> std::expected<Timestamp, ProbeError>
+{
+    return readTimestamp(ExifValues { exif }.tags);
+}
+
+auto FileInfoImage::readTimestamp(const ExifTags& tags) -> std::expected<Timestamp, ProbeError>
+{
+    const auto found = std::find_if(tags.dateTime.begin(), tags.dateTime.end(),
+        [](std::string_view value) { return value.data() != nullptr; });
+    if (found == tags.dateTime.end()) {
+        return std::unexpected { ProbeError { ProbeError::Reason::NoMetadata, "No date information found" } };
+    }
+    const auto i = static_cast<size_t>(std::distance(tags.dateTime.begin(), found));
+
+    Timestamp result;
+    const auto subSec = tags.subSec.at(i);
+    if (const auto local = parse_exif_timestamp(*found, subSec); local.has_value()) {
+        result.local = local.value();
+    } else if (const auto fallback = parse_timestamp(*found, subSec); fallback.has_value()) {
+        result.local = fallback.value();
+    } else {
+        return std::unexpected { fallback.error() };
     }
 
-    key = keysOffset.at(i);
-    if (exif.findKey(Exiv2::ExifKey { key }) != exif.end()) {
-        value = exif[key].toString();
-        timestamp.str(value);
-        timestamp.clear();
-        timestamp >> hours >> colon >> minutes;
-        if (hours < 0) {
-            minutes *= -1;
-        }
-        m_offset = std::chrono::hours(hours) + std::chrono::minutes(minutes);
+    const auto offset = tags.offset.at(i);
+    if (offset.data() != nullptr) {
+        const auto parsed = parse_utc_offset(offset);
+        result.offset = parsed.has_value() ? parsed.value() : parse_offset(offset);
     }
+    return { result };
 }
 
 auto FileInfoImage::accept(AbstractFileOperation& operation) const -> void
@@ -48,11 +48,36 @@ auto reset_exif_orientation(const fs::path& path) noexcept -> bool
 
 FileInfoImageJpeg::FileInfoImageJpeg(std::filesystem::path path, Exiv2::ExifData& exif)
     : FileInfoImage { std::move(path), exif }
+{
+    const auto orientation = readOrientation(exif);
+    if (!orientation.has_value()) {
+        throw FileInfoImageJpegError { orientation.error().message };
+    }
+    m_orientation = orientation.value();
+}
+
+FileInfoImageJpeg::FileInfoImageJpeg(std::filesystem::path path, const ExifTags& tags)
+    : FileInfoImage { std::move(path), tags }
+{
+    const auto orientation = readOrientation(tags);
+    if (!orientation.has_value()) {
+        throw FileInfoImageJpegError { orientation.error().message };
+    }
+    m_orientation = orientation.value();
+}
+
+FileInfoImageJpeg::FileInfoImageJpeg(std::filesystem::path path, const Timestamp& timestamp, Orientation orientation) noexcept
+    : FileInfoImage { std::move(path), timestamp }
+    , m_orientation { orientation }
+{
+}
+
+auto FileInfoImageJpeg::readOrientation(Exiv2::ExifData& exif) -> std::expected<Orientation, ProbeError>
 {
     const auto& item = exif.findKey(Exiv2::ExifKey { "Exif.Image.Orientation" });
 
     if (item == exif.end()) {
-        throw FileInfoImageJpegError { "Field 'Exif.Image.Orientation' not found in metadata" };
+        return std::unexpected { ProbeError { ProbeError::Reason::NoMetadata, "Field 'Exif.Image.Orientation' not found in metadata" } };
     }
 
 #ifdef EXIV2_HAS_TOLONG
@@ -62,10 +87,22 @@ FileInfoImageJpeg::FileInfoImageJpeg(std::filesystem::path path, Exiv2::ExifData
 #endif
 
     if (orientation < static_cast<long>(Orientation::ROT_0) || orientation > static_cast<long>(Orientation::ROT_90)) {
-        throw FileInfoImageJpegError { "Invalid orientation value" };
+        return std::unexpected { ProbeError { ProbeError::Reason::InvalidMetadata, "Invalid orientation value" } };
+    }
+
+    return { static_cast<Orientation>(orientation) };
+}
+
+auto FileInfoImageJpeg::readOrientation(const ExifTags& tags) -> std::expected<Orientation, ProbeError>
+{
+    if (tags.orientation == 0) {
+        return std::unexpected { ProbeError { ProbeError::Reason::NoMetadata, "Field 'Exif.Image.Orientation' not found in metadata" } };
+    }
+    if (tags.orientation < static_cast<uint16_t>(Orientation::ROT_0) || tags.orientation > static_cast<uint16_t>(Orientation::ROT_90)) {
+        return std::unexpected { ProbeError { ProbeError::Reason::InvalidMetadata, "Invalid orientation value" } };
     }
 
-    m_orientation = static_cast<Orientation>(orientation);
+    return { static_cast<Orientation>(tags.orientation) };
 }
 
 auto FileInfoImageJpeg::accept(AbstractFileOperation& operation) const -> void
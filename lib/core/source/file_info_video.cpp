@@ -18,6 +18,7 @@
 
 #include <mediacopier/abstract_operation.hpp>
 #include <mediacopier/error.hpp>
+#include <mediacopier/timestamp_parser.hpp>
 
 extern "C" {
 #include <libavformat/avformat.h>
@@ -30,6 +31,27 @@ namespace mediacopier {
 
 FileInfoVideo::FileInfoVideo(std::filesystem::path path)
     : AbstractFileInfo { path }
+{
+    setTimestamp(readTimestamp(m_path));
+}
+
+FileInfoVideo::FileInfoVideo(std::filesystem::path path, std::string_view timestamp)
+    : AbstractFileInfo { std::move(path) }
+{
+    setTimestamp(parseTimestamp(timestamp));
+}
+
+FileInfoVideo::FileInfoVideo(std::filesystem::path path, const Timestamp& timestamp) noexcept
+    : AbstractFileInfo { std::move(path), timestamp }
+{
+}
+
+auto FileInfoVideo::accept(AbstractFileOperation& operation) const -> void
+{
+    operation.visit(*this);
+}
+
+auto FileInfoVideo::readTimestamp(const std::filesystem::path& path) -> std::expected<Timestamp, ProbeError>
 {
     AVFormatContext* fmt_ctx = nullptr;
     AVDictionaryEntry* tag = nullptr;
@@ -39,9 +61,7 @@ FileInfoVideo::FileInfoVideo(std::filesystem::path path)
 
     if (ret != 0) {
         av_strerror(ret, errbuf.data(), sizeof(errbuf));
-        std::ostringstream oss;
-        oss << "Could not read metadata: " << errbuf.data();
-        throw FileInfoError { oss.str() };
+        return std::unexpected { ProbeError { ProbeError::Reason::NoMetadata, std::string { "Could not read metadata: " } + errbuf.data() } };
     }
 
     std::string timestamp;
@@ -60,31 +80,46 @@ FileInfoVideo::FileInfoVideo(std::filesystem::path path)
 
     avformat_close_input(&fmt_ctx);
 
+    return parseTimestamp(timestamp);
+}
+
+auto FileInfoVideo::parseTimestamp(std::string_view timestamp) -> std::expected<Timestamp, ProbeError>
+{
     if (timestamp.empty()) {
-        throw FileInfoError { "No date information found" };
+        return std::unexpected { ProbeError { ProbeError::Reason::NoMetadata, "No date information found" } };
     }
 
+    if (const auto parsed = parse_iso_timestamp(timestamp); parsed.has_value()) {
+        return { Timestamp { parsed->local, parsed->offset.value_or(std::chrono::minutes::zero()) } };
+    }
+
+    Timestamp result;
     std::chrono::system_clock::time_point tp;
 
-    std::istringstream iss { timestamp };
+    std::istringstream iss { std::string { timestamp } };
     iss >> std::chrono::parse("%FT%T", tp); // parse into local time (without timezone offset)
     if (iss.fail()) {
-        throw FileInfoError { "Invalid date information found" };
+        return std::unexpected { ProbeError { ProbeError::Reason::InvalidMetadata, "Invalid date information found" } };
     }
 
-    m_timestamp = tp;
+    result.local = tp;
 
     iss.seekg(0, std::ios::beg); // we want to parse the timestamp once more
     iss.clear();
     iss >> std::chrono::parse("%FT%T%z", tp); // parse into utc
     if (!iss.fail()) {
-        m_offset = std::chrono::duration_cast<std::chrono::minutes>(m_timestamp - tp);
+        result.offset = std::chrono::duration_cast<std::chrono::minutes>(result.local - tp);
     }
+    return { result };
 }
 
-auto FileInfoVideo::accept(AbstractFileOperation& operation) const -> void
+auto FileInfoVideo::setTimestamp(const std::expected<Timestamp, ProbeError>& timestamp) -> void
 {
-    operation.visit(*this);
+    if (!timestamp.has_value()) {
+        throw FileInfoError { timestamp.error().message };
+    }
+    m_timestamp = timestamp->local;
+    m_offset = timestamp->offset;
 }
 
 } // namespace mediacopier
@@ -16,119 +16,211 @@
 
 #include <mediacopier/file_register.hpp>
 
-#include <mediacopier/duplicate_check.hpp>
 #include <mediacopier/error.hpp>
 
 #include <spdlog/spdlog.h>
 
-#include <format>
+#include <algorithm>
+#include <charconv>
 
 namespace fs = std::filesystem;
 
-static void identify_replacement_field(std::string& fmt)
-{
-    auto it = fmt.begin();
-    while (true) {
-        it = std::find(it, fmt.end(), '%');
-        if (it == fmt.end()) {
-            break;
-        }
-        if (std::next(it) != fmt.end() && *std::next(it) == '%') {
-            it = std::next(it, 2); // skip %%
-            continue;
-        }
-        break; // first unescaped % found
-    }
-    if (it != fmt.end()) {
-        auto pos = std::distance(fmt.begin(), it);
-        fmt.insert(pos, "{:");
-    }
-    fmt.push_back('}');
-}
-
 namespace mediacopier {
 
-FileRegister::FileRegister(fs::path destination, std::string pattern, bool useUtc)
+FileRegister::FileRegister(fs::path destination, std::string pattern, bool useUtc, uint64_t compareBudget)
     : m_destdir { std::move(destination) }
     , m_pattern { std::move(pattern) }
     , m_useUtc { useUtc }
+    , m_duplicates { compareBudget }
+    , m_catalog { m_destdir }
 {
     m_destdir /= ""; // this will append a trailing directory separator when necessary
-    identify_replacement_field(m_pattern);
 }
 
-auto FileRegister::add(FileInfoPtr file) -> std::optional<fs::path>
+auto FileRegister::add(const AbstractFileInfo& file) -> std::optional<fs::path>
 {
-    std::vector<std::filesystem::path> conflicts;
+    // catches copies that end up with another name (e.g. a different timestamp) as well
+    if (const auto other = m_duplicates.find(file.path()); other.has_value()) {
+        spdlog::info("Ignoring duplicate: {0} (same as {1})", file.path().filename().string(), other->filename().string());
+        return {};
+    }
+    // imported by a previous run, possibly under another name
+    const auto size = m_duplicates.payloadSize(file.path());
+    if (m_catalog.containsSize(size)) {
+        const auto hash = m_duplicates.payloadHash(file.path());
+        if (const auto* record = m_catalog.find(hash); record != nullptr) {
+            if (existedBefore(m_destdir / record->destination)) {
+                spdlog::info("Ignoring already imported: {0} (same as {1})", file.path().filename().string(), record->destination);
+                return {};
+            }
+            m_catalog.remove(hash); // removed from the library meanwhile
+        }
+    }
+
+    std::vector<PathTable::Handle> conflicts;
     size_t suffix = 0;
+    renderDestination(file);
 
     while (suffix < std::numeric_limits<size_t>::max()) {
         auto dest = constructDestinationPath(file, suffix);
-        if (fs::exists(dest)) {
-            if (is_duplicate(file->path(), dest)) {
-                spdlog::info("Ignoring already existing: {0} (same as {1})", file->path().filename().string(), dest.filename().string());
+        const auto handle = m_paths.find(dest);
+        const auto item = handle.has_value() ? m_register.find(handle.value()) : m_register.end();
+        if (item != m_register.end()) {
+            // registered before, compare with the written file if the operation got to it already
+            const auto written = !m_pending.contains(handle.value()) && fs::exists(dest);
+            const auto other = written ? dest : m_paths.path(item->second);
+            if (m_duplicates.same(file.path(), other)) {
+                if (written) {
+                    spdlog::info("Ignoring already existing: {0} (same as {1})", file.path().filename().string(), other.filename().string());
+                } else {
+                    spdlog::info("Ignoring duplicate: {0} (same as {1})", file.path().filename().string(), other.filename().string());
+                }
                 return {};
             }
-            // possible duplicate of 'dest'
-            conflicts.push_back(dest);
+            // possible duplicate of 'item' at destination
+            conflicts.push_back(handle.value());
             ++suffix;
             continue;
         }
-        auto item = m_register.find(dest.string());
-        if (item != m_register.end()) {
-            if (is_duplicate(file->path(), item->second->path())) {
-                spdlog::info("Ignoring duplicate: {0} (same as {1})", file->path().filename().string(), item->second->path().filename().string());
+        if (existedBefore(dest)) {
+            if (m_duplicates.same(file.path(), dest)) {
+                spdlog::info("Ignoring already existing: {0} (same as {1})", file.path().filename().string(), dest.filename().string());
                 return {};
             }
-            // possible duplicate of 'item' at destination
-            conflicts.push_back(dest);
+            // possible duplicate of 'dest'
+            conflicts.push_back(m_paths.intern(dest));
             ++suffix;
             continue;
         }
+        const auto registered = m_paths.intern(dest);
         if (conflicts.size() > 0) {
-            m_conflicts[dest.string()] = std::move(conflicts);
+            m_conflicts[registered] = std::move(conflicts);
         }
-        m_register[dest.string()] = std::move(file);
+        const auto source = m_paths.intern(file.path());
+        m_register[registered] = source;
+        m_duplicates.add(file.path());
+        m_imported.push_back({ source, registered, size, std::chrono::duration_cast<std::chrono::nanoseconds>(file.timestamp().time_since_epoch()).count() });
         return { std::move(dest) };
     }
 
     throw FileInfoError { "Unable to find unique filename" };
 }
 
+auto FileRegister::setPending(const fs::path& destination) -> void
+{
+    m_pending.insert(m_paths.intern(destination));
+}
+
+auto FileRegister::setFinished(const fs::path& destination) -> void
+{
+    if (const auto handle = m_paths.find(destination); handle.has_value()) {
+        m_pending.erase(handle.value());
+    }
+}
+
 auto FileRegister::removeDuplicates() -> void
 {
+    const auto pending = [this](const auto& item) -> bool {
+        return m_pending.contains(item.first) || std::ranges::any_of(item.second, [this](auto conflict) { return m_pending.contains(conflict); });
+    };
+
     std::error_code err;
-    for (const auto& [path, conflicts] : m_conflicts) {
-        for (const auto& conflict : conflicts) {
-            if (fs::exists(path) && fs::exists(conflict) && is_duplicate(path, conflict)) {
-                spdlog::info("Removing duplicate: {0} same as {1}", path, conflict.string());
+    for (const auto& item : m_conflicts) {
+        if (pending(item)) {
+            continue; // compared once the copies are finished
+        }
+        const auto path = m_paths.path(item.first);
+        for (const auto& conflict : item.second) {
+            const auto other = m_paths.path(conflict);
+            if (fs::exists(path) && fs::exists(other) && m_duplicates.same(path, other)) {
+                spdlog::info("Removing duplicate: {0} same as {1}", path.string(), other.string());
+                m_duplicates.remove(path);
                 fs::remove(path, err);
                 if (err) {
-                    spdlog::warn("Failed to remove the duplicate file: ({0}): {1}", path, err.message());
+                    spdlog::warn("Failed to remove the duplicate file: ({0}): {1}", path.string(), err.message());
                 }
                 break;
             }
         }
     }
+    std::erase_if(m_conflicts, [&pending](const auto& item) { return !pending(item); });
 }
 
-auto FileRegister::constructDestinationPath(const FileInfoPtr& file, size_t suffix) const -> fs::path
+auto FileRegister::store() -> void
 {
-    std::ostringstream os;
-    os << m_destdir.string();
+    for (const auto& imported : m_imported) {
+        if (m_pending.contains(imported.destination)) {
+            continue; // stored once the copy is finished
+        }
+        const auto dest = m_paths.path(imported.destination);
+        std::error_code err;
+        if (!fs::exists(dest, err)) {
+            continue; // the operation failed, or it was removed as duplicate
+        }
+        try {
+            // the source was only hashed if another file had a payload of the same size
+            auto hash = m_duplicates.knownHash(m_paths.path(imported.source));
+            if (!hash.has_value()) {
+                hash = m_duplicates.payloadHash(dest);
+            }
+            m_catalog.add(hash.value(), { imported.size, imported.timestamp, dest.lexically_relative(m_destdir).generic_string(), true });
+        } catch (const MediaCopierError& err) {
+            spdlog::warn("Could not add {0} to the content catalog: {1}", dest.string(), err.what());
+        }
+    }
+    std::erase_if(m_imported, [this](const Imported& imported) { return !m_pending.contains(imported.destination); });
+    m_catalog.store();
+
+    if (m_pending.empty() && m_conflicts.empty()) {
+        m_register.clear();
+        m_listings.clear();
+        m_duplicates.clear();
+        m_paths = {};
+    }
+}
 
-    std::chrono::system_clock::time_point tp = file->timestamp();
+auto FileRegister::renderDestination(const AbstractFileInfo& file) -> void
+{
+    std::chrono::system_clock::time_point tp = file.timestamp();
     if (m_useUtc) {
-        tp -= file->offset(); // convert local time to utc
+        tp -= file.offset(); // convert local time to utc
     }
 
-    os << std::vformat(m_pattern, std::make_format_args(tp));
+    m_buffer = m_destdir.string();
+    m_pattern.render(tp, m_buffer);
+    m_stemLength = m_buffer.size();
+}
 
+auto FileRegister::constructDestinationPath(const AbstractFileInfo& file, size_t suffix) -> fs::path
+{
+    m_buffer.resize(m_stemLength);
     if (suffix > 0) {
-        os << "_" << suffix;
+        char digits[20];
+        const auto result = std::to_chars(std::begin(digits), std::end(digits), suffix);
+        m_buffer.push_back('_');
+        m_buffer.append(digits, result.ptr);
+    }
+    m_buffer.append(file.path().extension().string());
+    return { m_buffer };
+}
+
+auto FileRegister::existedBefore(const fs::path& path) -> bool
+{
+    const auto directory = path.parent_path();
+    auto listing = m_listings.find(directory.string());
+    if (listing == m_listings.end()) {
+        std::unordered_set<std::string> names;
+        std::error_code err;
+        for (auto it = fs::directory_iterator { directory, err }; !err && it != fs::directory_iterator {}; it.increment(err)) {
+            names.insert(it->path().filename().string());
+        }
+        if (err && err != std::errc::no_such_file_or_directory) {
+            spdlog::warn("Failed to list {0}: {1}", directory.string(), err.message());
+            return fs::exists(path);
+        }
+        listing = m_listings.emplace(directory.string(), std::move(names)).first;
     }
-    os << file->path().extension().string();
-    return { os.str() };
+    return listing->second.contains(path.filename().string());
 }
 
 } // namespace mediacopier
@@ -0,0 +1,83 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/file_source.hpp>
+
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+namespace mediacopier {
+
+FileSource::FileSource(fs::path path, std::span<const uint8_t> header, size_t readLimit)
+    : m_path { std::move(path) }
+    , m_header { header }
+    , m_readLimit { readLimit }
+{
+}
+
+auto FileSource::read(uint64_t offset, size_t length) -> std::span<const uint8_t>
+{
+    if (offset <= m_header.size() && length <= m_header.size() - offset) {
+        return m_header.subspan(static_cast<size_t>(offset), length);
+    }
+    for (const auto& extent : m_extents) {
+        if (offset >= extent.offset && offset - extent.offset <= extent.data.size()
+            && length <= extent.data.size() - (offset - extent.offset)) {
+            return std::span { extent.data }.subspan(static_cast<size_t>(offset - extent.offset), length);
+        }
+    }
+    if (!open() || offset > m_size || length > m_size - offset) {
+        return {};
+    }
+
+    const uint64_t begin = offset - (offset % BLOCK_SIZE);
+    const uint64_t end = std::min(((offset + length + BLOCK_SIZE - 1) / BLOCK_SIZE) * BLOCK_SIZE, m_size);
+    const auto count = static_cast<size_t>(end - begin);
+    if (m_bytesRead + count > m_readLimit) {
+        return {};
+    }
+
+    Extent extent { begin, std::vector<uint8_t>(count) };
+    m_input.clear();
+    m_input.seekg(static_cast<std::streamoff>(begin));
+    m_input.read(reinterpret_cast<char*>(extent.data.data()), static_cast<std::streamsize>(count));
+    m_bytesRead += count;
+    if (static_cast<size_t>(m_input.gcount()) != count) {
+        return {};
+    }
+    const auto& data = m_extents.emplace_back(std::move(extent)).data;
+    return std::span { data }.subspan(static_cast<size_t>(offset - begin), length);
+}
+
+auto FileSource::size() -> uint64_t
+{
+    return open() ? m_size : m_header.size();
+}
+
+auto FileSource::open() -> bool
+{
+    if (!m_opened) {
+        m_opened = true;
+        m_input.open(m_path, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+        if (m_input.is_open()) {
+            m_size = static_cast<uint64_t>(m_input.tellg());
+        }
+    }
+    return m_input.is_open();
+}
+
+} // namespace mediacopier
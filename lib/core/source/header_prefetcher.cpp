@@ -0,0 +1,295 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/header_prefetcher.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#ifdef HAS_LIBURING
+#include <fcntl.h>
+#include <liburing.h>
+#include <unistd.h>
+#endif
+
+constexpr static const size_t MAX_FALLBACK_THREADS = 8;
+
+namespace mediacopier {
+
+struct HeaderPrefetcher::Slot {
+    Entry entry;
+    int fd = -1;
+    size_t filled = 0; // bytes of the header read so far
+    bool done = false;
+};
+
+class HeaderPrefetcher::Backend {
+public:
+    virtual ~Backend() = default;
+    virtual auto submit(Slot& slot) -> void = 0;
+    virtual auto flush() -> void = 0;
+    virtual auto wait(Slot& slot) -> void = 0;
+};
+
+} // namespace mediacopier
+
+namespace {
+
+namespace mc = mediacopier;
+
+using Slot = mc::HeaderPrefetcher::Slot;
+
+class ThreadPoolBackend : public mc::HeaderPrefetcher::Backend {
+public:
+    ThreadPoolBackend(size_t threads, size_t headerSize)
+        : m_headerSize { headerSize }
+    {
+        for (size_t i = 0; i < threads; ++i) {
+            m_threads.emplace_back(&ThreadPoolBackend::run, this);
+        }
+    }
+    ~ThreadPoolBackend() override
+    {
+        {
+            std::lock_guard lock { m_mutex };
+            m_stopped = true;
+        }
+        m_submitted.notify_all();
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+    ThreadPoolBackend(const ThreadPoolBackend&) = delete;
+    ThreadPoolBackend& operator=(const ThreadPoolBackend&) = delete;
+    ThreadPoolBackend(ThreadPoolBackend&&) = delete;
+    ThreadPoolBackend& operator=(ThreadPoolBackend&&) = delete;
+
+    auto submit(Slot& slot) -> void override
+    {
+        {
+            std::lock_guard lock { m_mutex };
+            m_jobs.push_back(&slot);
+        }
+        m_submitted.notify_one();
+    }
+    auto flush() -> void override
+    {
+        // nothing to do, jobs are picked up immediately
+    }
+    auto wait(Slot& slot) -> void override
+    {
+        std::unique_lock lock { m_mutex };
+        m_completed.wait(lock, [&slot]() { return slot.done; });
+    }
+
+private:
+    auto run() -> void
+    {
+        while (true) {
+            std::unique_lock lock { m_mutex };
+            m_submitted.wait(lock, [this]() { return !m_jobs.empty() || m_stopped; });
+            if (m_jobs.empty()) {
+                return;
+            }
+            auto* slot = m_jobs.front();
+            m_jobs.pop_front();
+            lock.unlock();
+
+            auto& header = slot->entry.header;
+            header.resize(m_headerSize);
+            std::ifstream input { slot->entry.file.path, std::ios_base::in | std::ios_base::binary };
+            input.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()));
+            header.resize(static_cast<size_t>(input.gcount()));
+
+            lock.lock();
+            slot->done = true;
+            lock.unlock();
+            m_completed.notify_all();
+        }
+    }
+
+    size_t m_headerSize;
+    bool m_stopped = false;
+    std::deque<Slot*> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_submitted;
+    std::condition_variable m_completed;
+    std::vector<std::thread> m_threads;
+};
+
+#ifdef HAS_LIBURING
+class UringBackend : public mc::HeaderPrefetcher::Backend {
+public:
+    UringBackend(size_t depth, size_t headerSize)
+        : m_headerSize { headerSize }
+    {
+        const int ret = io_uring_queue_init(static_cast<unsigned>(depth), &m_ring, 0);
+        if (ret < 0) {
+            throw std::system_error { -ret, std::generic_category(), "io_uring_queue_init" };
+        }
+    }
+    ~UringBackend() override
+    {
+        io_uring_queue_exit(&m_ring);
+    }
+    UringBackend(const UringBackend&) = delete;
+    UringBackend& operator=(const UringBackend&) = delete;
+    UringBackend(UringBackend&&) = delete;
+    UringBackend& operator=(UringBackend&&) = delete;
+
+    auto submit(Slot& slot) -> void override
+    {
+        // opening is done synchronously, the directory entry was just read so it is cached anyway
+        slot.fd = ::open(slot.entry.file.path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (slot.fd < 0) {
+            slot.done = true;
+            return;
+        }
+        slot.entry.header.resize(m_headerSize);
+        queueRead(slot);
+    }
+    auto flush() -> void override
+    {
+        io_uring_submit(&m_ring);
+    }
+    auto wait(Slot& slot) -> void override
+    {
+        io_uring_cqe* cqe = nullptr;
+        while (!slot.done) {
+            const int ret = io_uring_wait_cqe(&m_ring, &cqe);
+            if (ret == -EINTR) {
+                continue;
+            }
+            if (ret < 0) {
+                throw std::system_error { -ret, std::generic_category(), "io_uring_wait_cqe" };
+            }
+            auto* completed = static_cast<Slot*>(io_uring_cqe_get_data(cqe));
+            const auto result = cqe->res;
+            io_uring_cqe_seen(&m_ring, cqe);
+            // reads may return less than requested, the rest is read until the file ends
+            if (result > 0) {
+                completed->filled += static_cast<size_t>(result);
+                if (completed->filled < m_headerSize) {
+                    queueRead(*completed);
+                    io_uring_submit(&m_ring);
+                    continue;
+                }
+            }
+            completed->entry.header.resize(completed->filled);
+            ::close(completed->fd);
+            completed->fd = -1;
+            completed->done = true;
+        }
+    }
+
+private:
+    auto queueRead(Slot& slot) -> void
+    {
+        auto* sqe = io_uring_get_sqe(&m_ring);
+        if (sqe == nullptr) {
+            io_uring_submit(&m_ring);
+            sqe = io_uring_get_sqe(&m_ring);
+        }
+        io_uring_prep_read(sqe, slot.fd, slot.entry.header.data() + slot.filled, static_cast<unsigned>(m_headerSize - slot.filled), slot.filled);
+        io_uring_sqe_set_data(sqe, &slot);
+    }
+
+    size_t m_headerSize;
+    io_uring m_ring {};
+};
+#endif
+
+auto make_backend(size_t depth, size_t headerSize) -> std::unique_ptr<mc::HeaderPrefetcher::Backend>
+{
+#ifdef HAS_LIBURING
+    try {
+        return std::make_unique<UringBackend>(depth, headerSize);
+    } catch (const std::system_error& err) {
+        spdlog::debug("io_uring not available, fallback to thread pool: {0}", err.what());
+    }
+#endif
+    return std::make_unique<ThreadPoolBackend>(std::min(depth, MAX_FALLBACK_THREADS), headerSize);
+}
+
+} // namespace
+
+namespace mediacopier {
+
+HeaderPrefetcher::HeaderPrefetcher(DirectoryWalker& walker, size_t depth, size_t headerSize)
+    : m_walker { walker }
+    , m_depth { std::max<size_t>(depth, 1) }
+    , m_backend { make_backend(m_depth, headerSize) }
+{
+}
+
+HeaderPrefetcher::~HeaderPrefetcher()
+{
+    // buffers must not be released while reads are still in flight
+    try {
+        for (auto& slot : m_slots) {
+            m_backend->wait(*slot);
+        }
+    } catch (const std::exception& err) {
+        // tearing down the backend cancels the remaining reads before the buffers go away
+        spdlog::error("Failed to wait for prefetched headers: {0}", err.what());
+        m_backend.reset();
+#ifdef HAS_LIBURING
+        for (auto& slot : m_slots) {
+            if (slot->fd >= 0) {
+                ::close(slot->fd);
+            }
+        }
+#endif
+    }
+}
+
+auto HeaderPrefetcher::next() -> std::optional<Entry>
+{
+    bool submitted = false;
+    while (!m_exhausted && m_slots.size() < m_depth) {
+        auto file = m_walker.next();
+        if (!file.has_value()) {
+            m_exhausted = true;
+            break;
+        }
+        if (m_filter && !m_filter(file.value())) {
+            continue;
+        }
+        auto slot = std::make_unique<Slot>();
+        slot->entry.file = std::move(file.value());
+        m_backend->submit(*slot);
+        m_slots.push_back(std::move(slot));
+        submitted = true;
+    }
+    if (submitted) {
+        m_backend->flush();
+    }
+    if (m_slots.empty()) {
+        return {};
+    }
+    auto slot = std::move(m_slots.front());
+    m_slots.pop_front();
+    m_backend->wait(*slot);
+    return { std::move(slot->entry) };
+}
+
+} // namespace mediacopier
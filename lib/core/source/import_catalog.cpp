@@ -0,0 +1,144 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/import_catalog.hpp>
+
+#include <mediacopier/catalog_file.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <fstream>
+
+constexpr static const char* IMPORT_CATALOG = ".mediacopier-imports";
+constexpr static const uint32_t IMPORT_CATALOG_MAGIC = 0x4d434943; // "MCIC"
+constexpr static const uint32_t IMPORT_CATALOG_VERSION = 1;
+constexpr static const uint32_t MAX_DESTINATION_LENGTH = 4096;
+constexpr static const std::chrono::seconds RETENTION = std::chrono::days { 180 };
+
+namespace fs = std::filesystem;
+
+static auto to_nanoseconds(std::chrono::system_clock::time_point time) -> int64_t
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+namespace mediacopier {
+
+auto ImportCatalog::KeyHash::operator()(const Key& key) const noexcept -> size_t
+{
+    return std::hash<uint64_t> {}(key.inode) ^ (std::hash<uint64_t> {}(key.device) << 1);
+}
+
+ImportCatalog::ImportCatalog(fs::path outputDir)
+    : m_catalogFile { std::move(outputDir) / IMPORT_CATALOG }
+    , m_now { std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count() }
+{
+    load();
+}
+
+auto ImportCatalog::find(const DirectoryWalker::Entry& entry) const -> const Record*
+{
+    if (entry.inode == 0) {
+        return nullptr;
+    }
+    const auto it = m_records.find({ entry.device, entry.inode });
+    if (it == m_records.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+auto ImportCatalog::isUnchanged(const DirectoryWalker::Entry& entry) -> bool
+{
+    if (entry.inode == 0) {
+        return false;
+    }
+    const auto it = m_records.find({ entry.device, entry.inode });
+    if (it == m_records.end()) {
+        return false;
+    }
+    auto& record = it->second;
+    if (record.size != entry.size || record.modified != to_nanoseconds(entry.modified)) {
+        return false;
+    }
+    record.seen = m_now;
+    return record.outcome != Outcome::Error;
+}
+
+auto ImportCatalog::record(const DirectoryWalker::Entry& entry, Outcome outcome, const fs::path& destination) -> void
+{
+    if (entry.inode == 0) {
+        return;
+    }
+    m_records.insert_or_assign({ entry.device, entry.inode },
+        Record { entry.size, to_nanoseconds(entry.modified), m_now, outcome, destination.string() });
+}
+
+auto ImportCatalog::load() -> void
+{
+    std::ifstream is { m_catalogFile, std::ios_base::in | std::ios_base::binary };
+    if (!is.is_open()) {
+        return;
+    }
+    const auto count = read_catalog_header(is, IMPORT_CATALOG_MAGIC, IMPORT_CATALOG_VERSION);
+    if (!count.has_value()) {
+        spdlog::warn("Ignoring unknown import catalog: {0}", m_catalogFile.string());
+        return;
+    }
+    for (uint64_t i = 0; i < count.value(); ++i) {
+        Key key {};
+        Record record {};
+        uint8_t outcome = 0;
+        if (!read_value(is, key.device) || !read_value(is, key.inode) || !read_value(is, record.size)
+            || !read_value(is, record.modified) || !read_value(is, record.seen) || !read_value(is, outcome)
+            || !read_string(is, record.destination, MAX_DESTINATION_LENGTH)) {
+            spdlog::warn("Ignoring truncated import catalog: {0}", m_catalogFile.string());
+            m_records.clear();
+            return;
+        }
+        record.outcome = static_cast<Outcome>(outcome);
+        m_records.emplace(key, std::move(record));
+    }
+}
+
+auto ImportCatalog::store() const -> void
+{
+    const auto expired = m_now - RETENTION.count();
+    uint64_t count = 0;
+    for (const auto& [key, record] : m_records) {
+        count += record.seen >= expired ? 1 : 0;
+    }
+
+    store_catalog_file(m_catalogFile, [this, expired, count](std::ostream& os) {
+        write_catalog_header(os, IMPORT_CATALOG_MAGIC, IMPORT_CATALOG_VERSION, count);
+        for (const auto& [key, record] : m_records) {
+            if (record.seen < expired) {
+                continue;
+            }
+            write_value(os, key.device);
+            write_value(os, key.inode);
+            write_value(os, record.size);
+            write_value(os, record.modified);
+            write_value(os, record.seen);
+            write_value(os, static_cast<uint8_t>(record.outcome));
+            // too long destinations are dropped, they are only informative
+            write_string(os, record.destination.size() <= MAX_DESTINATION_LENGTH ? std::string_view { record.destination } : std::string_view {});
+        }
+    });
+}
+
+} // namespace mediacopier
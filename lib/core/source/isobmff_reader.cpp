@@ -0,0 +1,413 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/isobmff_reader.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <string_view>
+
+namespace {
+
+namespace mc = mediacopier;
+
+consteval auto fourcc(std::string_view type) -> uint32_t
+{
+    return (static_cast<uint32_t>(type[0]) << 24) | (static_cast<uint32_t>(type[1]) << 16)
+        | (static_cast<uint32_t>(type[2]) << 8) | static_cast<uint32_t>(type[3]);
+}
+
+enum BoxType : uint32_t {
+    Cmt1 = fourcc("CMT1"),
+    Cmt2 = fourcc("CMT2"),
+    Data = fourcc("data"),
+    Exif = fourcc("Exif"),
+    Hdlr = fourcc("hdlr"),
+    Iinf = fourcc("iinf"),
+    Ilst = fourcc("ilst"),
+    Iloc = fourcc("iloc"),
+    Infe = fourcc("infe"),
+    Keys = fourcc("keys"),
+    Mdta = fourcc("mdta"),
+    Meta = fourcc("meta"),
+    Moov = fourcc("moov"),
+    Mvhd = fourcc("mvhd"),
+    Udta = fourcc("udta"),
+    Uuid = fourcc("uuid"),
+};
+
+constexpr static const std::string_view APPLE_CREATION_DATE { "com.apple.quicktime.creationdate" };
+constexpr static const uint32_t WELL_KNOWN_UTF8 = 1;
+constexpr static const uint64_t MAC_EPOCH_OFFSET = 2082844800; // seconds from 1904 to 1970
+
+constexpr static const std::array<uint8_t, 16> CANON_UUID = {
+    0x85, 0xC0, 0xB6, 0x87, 0x82, 0x0F, 0x11, 0xE0, 0x81, 0x11, 0xF4, 0xCE, 0x46, 0x2B, 0x6A, 0x48
+};
+
+struct Box {
+    uint32_t type = 0;
+    uint64_t offset = 0; // of the payload
+    uint64_t size = 0; // of the payload
+    auto end() const noexcept -> uint64_t { return offset + size; }
+};
+
+auto read_be(std::span<const uint8_t> data, size_t pos, size_t size) noexcept -> uint64_t
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value = (value << 8) | data[pos + i];
+    }
+    return value;
+}
+
+// calls `visit` for each box within [begin, end), false if the boxes can't be
+// followed or the visitor fails
+template <typename Visitor>
+auto for_each_box(mc::FileSource& source, uint64_t begin, uint64_t end, Visitor&& visit) -> bool
+{
+    uint64_t pos = begin;
+    // some writers pad containers with a few zero bytes
+    while (pos < end && end - pos >= 8) {
+        const auto header = source.read(pos, 8);
+        if (header.size() != 8) {
+            return false;
+        }
+        uint64_t size = read_be(header, 0, 4);
+        uint64_t headerSize = 8;
+        if (size == 1) {
+            const auto largeSize = source.read(pos + 8, 8);
+            if (largeSize.size() != 8) {
+                return false;
+            }
+            size = read_be(largeSize, 0, 8);
+            headerSize = 16;
+        } else if (size == 0) {
+            size = end - pos; // box extends to the end of its container
+        }
+        if (size < headerSize || size > end - pos) {
+            return false;
+        }
+        if (!visit(Box { static_cast<uint32_t>(read_be(header, 4, 4)), pos + headerSize, size - headerSize })) {
+            return false;
+        }
+        pos += size;
+    }
+    return true;
+}
+
+auto read_mvhd(mc::FileSource& source, const Box& mvhd, uint64_t& creationTime) -> bool
+{
+    const auto data = source.read(mvhd.offset, 12);
+    if (mvhd.size < 12 || data.size() != 12) {
+        return false;
+    }
+    creationTime = data[0] == 1 ? read_be(data, 4, 8) : read_be(data, 4, 4);
+    return true;
+}
+
+// 'keys' lists the names of the 'ilst' items, indices start at one
+auto find_key(mc::FileSource& source, const Box& keys, std::string_view name, uint32_t& index) -> bool
+{
+    const auto header = source.read(keys.offset, 8);
+    if (keys.size < 8 || header.size() != 8) {
+        return false;
+    }
+    const auto count = read_be(header, 4, 4);
+    uint64_t pos = keys.offset + 8;
+    for (uint32_t i = 1; i <= count; ++i) {
+        const auto entry = source.read(pos, 8);
+        if (entry.size() != 8) {
+            return false;
+        }
+        const uint64_t size = read_be(entry, 0, 4);
+        if (size < 8 || size > keys.end() - pos) {
+            return false;
+        }
+        if (read_be(entry, 4, 4) == BoxType::Mdta && size - 8 == name.size()) {
+            const auto key = source.read(pos + 8, name.size());
+            if (key.size() != name.size()) {
+                return false;
+            }
+            if (std::ranges::equal(key, name, [](uint8_t a, char b) { return a == static_cast<uint8_t>(b); })) {
+                index = i;
+                return true;
+            }
+        }
+        pos += size;
+    }
+    return true;
+}
+
+auto read_apple_creation_date(mc::FileSource& source, const Box& meta, std::string& value) -> bool
+{
+    // quicktime 'meta' boxes have no version and flags, unlike the iso ones
+    const auto header = source.read(meta.offset, 8);
+    if (header.size() != 8) {
+        return false;
+    }
+    const uint64_t skip = read_be(header, 4, 4) == BoxType::Hdlr ? 0 : 4;
+
+    uint32_t index = 0;
+    Box ilst {};
+    const auto& visitMeta = [&](const Box& child) -> bool {
+        if (child.type == BoxType::Keys) {
+            return find_key(source, child, APPLE_CREATION_DATE, index);
+        }
+        if (child.type == BoxType::Ilst) {
+            ilst = child;
+        }
+        return true;
+    };
+    if (!for_each_box(source, meta.offset + skip, meta.end(), visitMeta)) {
+        return false;
+    }
+    if (index == 0 || ilst.type == 0) {
+        return true;
+    }
+
+    const auto& visitData = [&](const Box& data) -> bool {
+        if (data.type != BoxType::Data) {
+            return true;
+        }
+        // type indicator, locale, value
+        const auto indicator = source.read(data.offset, 8);
+        if (data.size < 8 || indicator.size() != 8) {
+            return false;
+        }
+        if (read_be(indicator, 0, 4) != WELL_KNOWN_UTF8) {
+            return true;
+        }
+        const auto text = source.read(data.offset + 8, static_cast<size_t>(data.size - 8));
+        if (text.size() != data.size - 8) {
+            return false;
+        }
+        value.assign(text.begin(), text.end());
+        return true;
+    };
+    return for_each_box(source, ilst.offset, ilst.end(), [&](const Box& item) -> bool {
+        return item.type != index || for_each_box(source, item.offset, item.end(), visitData);
+    });
+}
+
+auto find_exif_item(mc::FileSource& source, const Box& iinf, std::optional<uint32_t>& itemId) -> bool
+{
+    const auto header = source.read(iinf.offset, 4);
+    if (header.size() != 4) {
+        return false;
+    }
+    const uint64_t begin = iinf.offset + (header[0] == 0 ? 6 : 8);
+    return for_each_box(source, begin, iinf.end(), [&](const Box& infe) -> bool {
+        if (infe.type != BoxType::Infe) {
+            return true;
+        }
+        const auto version = source.read(infe.offset, 1);
+        if (version.size() != 1) {
+            return false;
+        }
+        if (version[0] < 2) {
+            return true; // no item types before version 2
+        }
+        const size_t idSize = version[0] == 2 ? 2 : 4;
+        const size_t length = 4 + idSize + 2 + 4; // version and flags, item id, protection index, item type
+        const auto data = source.read(infe.offset, length);
+        if (infe.size < length || data.size() != length) {
+            return false;
+        }
+        if (read_be(data, 4 + idSize + 2, 4) == BoxType::Exif) {
+            itemId = static_cast<uint32_t>(read_be(data, 4, idSize));
+        }
+        return true;
+    });
+}
+
+// file offset of an item stored in a single extent, empty if it isn't there
+// or stored in a way that isn't supported (e.g. within 'idat')
+auto find_item_offset(mc::FileSource& source, const Box& iloc, uint32_t itemId) -> std::optional<uint64_t>
+{
+    const auto data = source.read(iloc.offset, static_cast<size_t>(iloc.size));
+    if (data.size() != iloc.size || data.size() < 8) {
+        return {};
+    }
+    const uint8_t version = data[0];
+    const size_t offsetSize = data[4] >> 4;
+    const size_t lengthSize = data[4] & 0x0F;
+    const size_t baseOffsetSize = data[5] >> 4;
+    const size_t indexSize = version >= 1 ? data[5] & 0x0F : 0;
+
+    size_t pos = 6;
+    bool valid = true;
+    const auto& field = [&](size_t size) -> uint64_t {
+        if ((size != 0 && size != 2 && size != 4 && size != 8) || size > data.size() - pos) {
+            valid = false;
+            return 0;
+        }
+        const auto value = read_be(data, pos, size);
+        pos += size;
+        return value;
+    };
+
+    const auto count = field(version < 2 ? 2 : 4);
+    for (uint64_t i = 0; i < count && valid; ++i) {
+        const auto id = field(version < 2 ? 2 : 4);
+        const auto constructionMethod = version >= 1 ? field(2) & 0x0F : 0;
+        field(2); // data reference index
+        const auto baseOffset = field(baseOffsetSize);
+        const auto extentCount = field(2);
+        for (uint64_t j = 0; j < extentCount && valid; ++j) {
+            field(indexSize);
+            const auto extentOffset = field(offsetSize);
+            field(lengthSize);
+            if (valid && id == itemId) {
+                if (constructionMethod != 0 || extentCount != 1) {
+                    return {};
+                }
+                return { baseOffset + extentOffset };
+            }
+        }
+    }
+    return {};
+}
+
+// the 'Exif' item starts with the offset of the tiff header within the item
+auto read_heif_exif(mc::FileSource& source, const Box& meta, mc::ExifTags& tags, bool& found) -> bool
+{
+    std::optional<uint32_t> itemId;
+    Box iloc {};
+    const auto& visitMeta = [&](const Box& child) -> bool {
+        if (child.type == BoxType::Iinf) {
+            return find_exif_item(source, child, itemId);
+        }
+        if (child.type == BoxType::Iloc) {
+            iloc = child;
+        }
+        return true;
+    };
+    if (!for_each_box(source, meta.offset + 4, meta.end(), visitMeta)) {
+        return false;
+    }
+    if (!itemId.has_value() || iloc.type == 0) {
+        return true;
+    }
+
+    const auto item = find_item_offset(source, iloc, itemId.value());
+    if (!item.has_value()) {
+        return false;
+    }
+    const auto header = source.read(item.value(), 4);
+    if (header.size() != 4) {
+        return false;
+    }
+    const auto exif = mc::read_exif_tags(source, item.value() + 4 + read_be(header, 0, 4));
+    if (!exif.has_value()) {
+        return false;
+    }
+    tags = exif.value();
+    found = true;
+    return true;
+}
+
+auto read_canon_metadata(mc::FileSource& source, const Box& uuid, mc::ExifTags& tags, bool& found) -> bool
+{
+    const auto id = source.read(uuid.offset, CANON_UUID.size());
+    if (id.size() != CANON_UUID.size()) {
+        return false;
+    }
+    if (!std::ranges::equal(id, CANON_UUID)) {
+        return true;
+    }
+    return for_each_box(source, uuid.offset + CANON_UUID.size(), uuid.end(), [&](const Box& child) -> bool {
+        if (child.type == BoxType::Cmt1) {
+            found = true;
+            return mc::read_exif_ifd_tags(source, child.offset, mc::TiffIfd::Image, tags);
+        }
+        if (child.type == BoxType::Cmt2) {
+            found = true;
+            return mc::read_exif_ifd_tags(source, child.offset, mc::TiffIfd::Exif, tags);
+        }
+        return true;
+    });
+}
+
+} // namespace
+
+namespace mediacopier {
+
+auto read_isobmff_creation_time(FileSource& source) -> std::optional<std::string>
+{
+    uint64_t creationTime = 0;
+    std::string creationDate;
+
+    const auto& visitMoov = [&](const Box& child) -> bool {
+        switch (child.type) {
+        case BoxType::Mvhd:
+            return read_mvhd(source, child, creationTime);
+        case BoxType::Meta:
+            return read_apple_creation_date(source, child, creationDate);
+        case BoxType::Udta:
+            return for_each_box(source, child.offset, child.end(), [&](const Box& entry) -> bool {
+                return entry.type != BoxType::Meta || read_apple_creation_date(source, entry, creationDate);
+            });
+        default:
+            return true;
+        }
+    };
+    const bool valid = for_each_box(source, 0, source.size(), [&](const Box& box) -> bool {
+        return box.type != BoxType::Moov || for_each_box(source, box.offset, box.end(), visitMoov);
+    });
+    if (!valid) {
+        return {};
+    }
+
+    if (!creationDate.empty()) {
+        return { creationDate };
+    }
+    if (creationTime == 0) {
+        return { std::string {} };
+    }
+    // like libav, some writers use the unix epoch
+    if (creationTime >= MAC_EPOCH_OFFSET) {
+        creationTime -= MAC_EPOCH_OFFSET;
+    }
+    const std::chrono::sys_seconds timestamp { std::chrono::seconds { static_cast<int64_t>(creationTime) } };
+    return { std::format("{:%FT%T}.000000Z", timestamp) };
+}
+
+auto read_isobmff_exif_tags(FileSource& source) -> std::optional<ExifTags>
+{
+    ExifTags tags;
+    bool found = false;
+
+    const bool valid = for_each_box(source, 0, source.size(), [&](const Box& box) -> bool {
+        switch (box.type) {
+        case BoxType::Meta:
+            return read_heif_exif(source, box, tags, found);
+        case BoxType::Moov:
+            return for_each_box(source, box.offset, box.end(), [&](const Box& child) -> bool {
+                return child.type != BoxType::Uuid || read_canon_metadata(source, child, tags, found);
+            });
+        default:
+            return true;
+        }
+    });
+    if (!valid || !found) {
+        return {};
+    }
+    return { tags };
+}
+
+} // namespace mediacopier
@@ -0,0 +1,123 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/metadata_prober.hpp>
+
+#include <mediacopier/file_info_factory.hpp>
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+
+// results ready for hand-off per thread, keeps the threads busy while the consumer is slow
+constexpr static const size_t SLOTS_PER_THREAD = 2;
+
+namespace mediacopier {
+
+MetadataProber::MetadataProber(HeaderPrefetcher& prefetcher, size_t threads)
+    : m_prefetcher { prefetcher }
+{
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    m_slots.resize(threads * SLOTS_PER_THREAD);
+
+    // the xmp toolkit is initialized lazily by exiv2, which isn't thread-safe,
+    // everything else is fine as long as each thread opens its own images
+    Exiv2::XmpParser::initialize();
+
+    for (size_t i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&MetadataProber::run, this);
+    }
+}
+
+MetadataProber::~MetadataProber()
+{
+    // queued jobs are dropped, running ones are finished before the slots are released
+    {
+        std::lock_guard lock { m_mutex };
+        m_stopped = true;
+    }
+    m_submitted.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+auto MetadataProber::probe(DirectoryWalker::Entry file, std::span<const uint8_t> header) -> Entry
+{
+    Entry entry { std::move(file) };
+    try {
+        entry.info = header.empty() ? to_file_info(entry.file.path) : to_file_info(entry.file.path, header);
+    } catch (...) {
+        entry.error = std::current_exception();
+    }
+    return entry;
+}
+
+auto MetadataProber::next() -> std::optional<Entry>
+{
+    while (!m_exhausted && m_pending < m_slots.size()) {
+        auto input = m_prefetcher.next();
+        if (!input.has_value()) {
+            m_exhausted = true;
+            break;
+        }
+        auto& slot = m_slots[(m_head + m_pending) % m_slots.size()];
+        slot.input = std::move(input.value());
+        {
+            std::lock_guard lock { m_mutex };
+            slot.done = false;
+            m_jobs.push_back(&slot);
+        }
+        m_submitted.notify_one();
+        ++m_pending;
+    }
+    if (m_pending == 0) {
+        return {};
+    }
+    auto& slot = m_slots[m_head];
+    m_head = (m_head + 1) % m_slots.size();
+    --m_pending;
+    std::unique_lock lock { m_mutex };
+    m_completed.wait(lock, [&slot]() { return slot.done; });
+    return { std::move(slot.result) };
+}
+
+auto MetadataProber::run() -> void
+{
+    while (true) {
+        std::unique_lock lock { m_mutex };
+        m_submitted.wait(lock, [this]() { return !m_jobs.empty() || m_stopped; });
+        if (m_stopped) {
+            return;
+        }
+        auto* slot = m_jobs.front();
+        m_jobs.pop_front();
+        lock.unlock();
+
+        auto result = probe(std::move(slot->input.file), slot->input.header);
+        slot->input.header = {};
+
+        lock.lock();
+        slot->result = std::move(result);
+        slot->done = true;
+        lock.unlock();
+        m_completed.notify_all();
+    }
+}
+
+} // namespace mediacopier
@@ -0,0 +1,240 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/naming_pattern.hpp>
+
+#include <mediacopier/persistent_config.hpp>
+
+#include <format>
+#include <string_view>
+
+namespace {
+
+using namespace std::chrono;
+
+using TimeOfDay = hh_mm_ss<system_clock::duration>;
+
+auto find_replacement_field(std::string_view pattern) -> size_t
+{
+    for (size_t pos = pattern.find('%'); pos != std::string_view::npos; pos = pattern.find('%', pos + 2)) {
+        if (pos + 1 >= pattern.size() || pattern[pos + 1] != '%') {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+auto append_number(std::string& output, int64_t value, size_t width) -> void
+{
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    for (; count < width; --width) {
+        output.push_back('0');
+    }
+    while (count > 0) {
+        output.push_back(digits[--count]);
+    }
+}
+
+// seconds are printed with the precision of the clock, like std::format does
+auto append_seconds(std::string& output, const TimeOfDay& time) -> void
+{
+    append_number(output, time.seconds().count(), 2);
+    if constexpr (TimeOfDay::fractional_width > 0) {
+        output.push_back('.');
+        append_number(output, time.subseconds().count(), TimeOfDay::fractional_width);
+    }
+}
+
+} // namespace
+
+namespace mediacopier {
+
+NamingPattern::NamingPattern(std::string pattern)
+{
+    if (compile(pattern)) {
+        m_default = pattern == DEFAULT_PATTERN;
+    } else {
+        m_literals.clear();
+        m_tokens.clear();
+    }
+
+    // the chrono spec starts at the first unescaped %
+    m_format = std::move(pattern);
+    if (const auto pos = find_replacement_field(m_format); pos != std::string::npos) {
+        m_format.insert(pos, "{:");
+    }
+    m_format.push_back('}');
+}
+
+auto NamingPattern::render(system_clock::time_point tp, std::string& output) const -> void
+{
+    if (m_tokens.empty()) {
+        renderFormat(tp, output);
+        return;
+    }
+
+    const auto day = floor<days>(tp);
+    const year_month_day date { day };
+    const TimeOfDay time { tp - day };
+    const auto year = static_cast<int>(date.year());
+    if (year < 0 || year > 9999) {
+        renderFormat(tp, output);
+        return;
+    }
+    const auto dayOfYear = (day - sys_days { date.year() / January / 1 }).count();
+    const weekday dayOfWeek { day };
+
+    if (m_default) {
+        // '%Y/%W/IMG_%Y%m%d_%H%M%S'
+        append_number(output, year, 4);
+        output.push_back('/');
+        append_number(output, (dayOfYear + 7 - (dayOfWeek.c_encoding() + 6) % 7) / 7, 2);
+        output.append("/IMG_");
+        append_number(output, year, 4);
+        append_number(output, static_cast<unsigned>(date.month()), 2);
+        append_number(output, static_cast<unsigned>(date.day()), 2);
+        output.push_back('_');
+        append_number(output, time.hours().count(), 2);
+        append_number(output, time.minutes().count(), 2);
+        append_seconds(output, time);
+        return;
+    }
+
+    for (const auto& token : m_tokens) {
+        switch (token.field) {
+        case Field::Literal:
+            output.append(m_literals, token.offset, token.length);
+            break;
+        case Field::Year:
+            append_number(output, year, 4);
+            break;
+        case Field::YearOfCentury:
+            append_number(output, year % 100, 2);
+            break;
+        case Field::Month:
+            append_number(output, static_cast<unsigned>(date.month()), 2);
+            break;
+        case Field::Day:
+            append_number(output, static_cast<unsigned>(date.day()), 2);
+            break;
+        case Field::DayOfYear:
+            append_number(output, dayOfYear + 1, 3);
+            break;
+        case Field::Hour:
+            append_number(output, time.hours().count(), 2);
+            break;
+        case Field::Minute:
+            append_number(output, time.minutes().count(), 2);
+            break;
+        case Field::Second:
+            append_seconds(output, time);
+            break;
+        case Field::WeekOfYearSunday:
+            append_number(output, (dayOfYear + 7 - dayOfWeek.c_encoding()) / 7, 2);
+            break;
+        case Field::WeekOfYearMonday:
+            append_number(output, (dayOfYear + 7 - (dayOfWeek.c_encoding() + 6) % 7) / 7, 2);
+            break;
+        }
+    }
+}
+
+auto NamingPattern::compile(const std::string& pattern) -> bool
+{
+    const auto addLiteral = [this](std::string_view text) {
+        if (m_tokens.empty() || m_tokens.back().field != Field::Literal) {
+            m_tokens.push_back({ Field::Literal, static_cast<uint32_t>(m_literals.size()), 0 });
+        }
+        m_literals.append(text);
+        m_tokens.back().length += static_cast<uint32_t>(text.size());
+    };
+
+    // braces have a meaning for std::format, these patterns are left to it
+    const auto start = find_replacement_field(pattern);
+    if (start == std::string::npos || pattern.find_first_of("{}") != std::string::npos) {
+        return false;
+    }
+    // the leading text is not part of the chrono spec, so %% is kept as is
+    if (start > 0) {
+        addLiteral(std::string_view { pattern }.substr(0, start));
+    }
+
+    for (size_t pos = start; pos < pattern.size(); ++pos) {
+        if (pattern[pos] != '%') {
+            addLiteral(std::string_view { pattern }.substr(pos, 1));
+            continue;
+        }
+        if (++pos == pattern.size()) {
+            return false;
+        }
+        switch (pattern[pos]) {
+        case 'Y':
+            m_tokens.push_back({ Field::Year });
+            break;
+        case 'y':
+            m_tokens.push_back({ Field::YearOfCentury });
+            break;
+        case 'm':
+            m_tokens.push_back({ Field::Month });
+            break;
+        case 'd':
+            m_tokens.push_back({ Field::Day });
+            break;
+        case 'j':
+            m_tokens.push_back({ Field::DayOfYear });
+            break;
+        case 'H':
+            m_tokens.push_back({ Field::Hour });
+            break;
+        case 'M':
+            m_tokens.push_back({ Field::Minute });
+            break;
+        case 'S':
+            m_tokens.push_back({ Field::Second });
+            break;
+        case 'U':
+            m_tokens.push_back({ Field::WeekOfYearSunday });
+            break;
+        case 'W':
+            m_tokens.push_back({ Field::WeekOfYearMonday });
+            break;
+        case '%':
+            addLiteral("%");
+            break;
+        case 'n':
+            addLiteral("\n");
+            break;
+        case 't':
+            addLiteral("\t");
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+auto NamingPattern::renderFormat(system_clock::time_point tp, std::string& output) const -> void
+{
+    std::vformat_to(std::back_inserter(output), m_format, std::make_format_args(tp));
+}
+
+} // namespace mediacopier
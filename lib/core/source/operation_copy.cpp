@@ -16,6 +16,8 @@
 
 #include <mediacopier/operation_copy.hpp>
 
+#include <mediacopier/copy_engine.hpp>
+#include <mediacopier/copy_verifier.hpp>
 #include <mediacopier/file_info_image_jpeg.hpp>
 #include <mediacopier/file_info_video.hpp>
 #include <spdlog/spdlog.h>
@@ -32,7 +34,11 @@ auto FileOperationCopy::copyFile(const AbstractFileInfo& file) const -> void
         spdlog::warn("Could not create parent path ({0}): {1}", m_destination.parent_path().string(), err.message());
         return;
     }
-    fs::copy_file(file.path(), m_destination, fs::copy_options::overwrite_existing); // may throw
+    if (m_verifier != nullptr) {
+        m_verifier->copy(file.path(), m_destination); // may throw
+    } else {
+        fast_copy(file.path(), m_destination); // may throw
+    }
 }
 
 auto FileOperationCopy::visit(const FileInfoImage& file) -> void
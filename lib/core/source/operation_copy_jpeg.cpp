@@ -16,6 +16,7 @@
 
 #include <mediacopier/operation_copy_jpeg.hpp>
 
+#include <mediacopier/copy_verifier.hpp>
 #include <mediacopier/file_info_video.hpp>
 #include <spdlog/spdlog.h>
 
@@ -134,6 +135,9 @@ auto FileOperationCopyJpeg::copyFileJpeg(const FileInfoImageJpeg& file) const ->
     }
     if (file.orientation() != upright) {
         if (copy_rotate_jpeg(file, m_destination) && reset_exif_orientation(m_destination)) {
+            if (m_verifier != nullptr) {
+                m_verifier->record(m_destination); // differs from the original by design
+            }
             return; // operation ok
         }
         spdlog::warn("Fallback to regular copy operation for {}", file.path().string());
@@ -0,0 +1,79 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/operation_link.hpp>
+
+#include <mediacopier/copy_engine.hpp>
+#include <mediacopier/error.hpp>
+#include <mediacopier/file_info_image_jpeg.hpp>
+#include <mediacopier/file_info_video.hpp>
+#include <spdlog/spdlog.h>
+
+namespace fs = std::filesystem;
+
+namespace mediacopier {
+
+// errors of links between file systems or on file systems without hard links
+static auto is_unsupported(const std::error_code& err) -> bool
+{
+    return err == std::errc::cross_device_link || err == std::errc::operation_not_permitted
+        || err == std::errc::too_many_links || err == std::errc::operation_not_supported;
+}
+
+auto FileOperationLink::linkFile(const AbstractFileInfo& file) const -> void
+{
+    std::error_code err;
+    fs::create_directories(m_destination.parent_path(), err);
+    if (err.value()) {
+        spdlog::warn("Could not create parent path ({0}): {1}", m_destination.parent_path().string(), err.message());
+        return;
+    }
+    fs::create_hard_link(file.path(), m_destination, err);
+    if (err == std::errc::file_exists) {
+        // replaced like the copy operation does
+        fs::remove(m_destination, err);
+        if (!err) {
+            fs::create_hard_link(file.path(), m_destination, err);
+        }
+    }
+    if (!err) {
+        const auto size = fs::file_size(m_destination, err);
+        copy_stats().record(CopyMethod::Hardlink, err ? 0 : size);
+        return;
+    }
+    if (!is_unsupported(err)) {
+        throw FileOperationError { "Failed to link file " + file.path().string() + ": " + err.message() };
+    }
+    spdlog::debug("Hard link not possible ({0}), fallback to copy", err.message());
+    fast_copy(file.path(), m_destination); // may throw
+}
+
+auto FileOperationLink::visit(const FileInfoImage& file) -> void
+{
+    linkFile(file);
+}
+
+auto FileOperationLink::visit(const FileInfoImageJpeg& file) -> void
+{
+    linkFile(file);
+}
+
+auto FileOperationLink::visit(const FileInfoVideo& file) -> void
+{
+    linkFile(file);
+}
+
+} // namespace mediacopier
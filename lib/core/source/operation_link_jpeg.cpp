@@ -0,0 +1,62 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/operation_link_jpeg.hpp>
+
+#include <mediacopier/file_info_video.hpp>
+#include <mediacopier/operation_copy_jpeg.hpp>
+#include <spdlog/spdlog.h>
+
+namespace fs = std::filesystem;
+
+namespace mediacopier {
+
+constexpr static const auto upright = FileInfoImageJpeg::Orientation::ROT_0;
+
+auto FileOperationLinkJpeg::linkFileJpeg(const FileInfoImageJpeg& file) const -> void
+{
+    std::error_code err;
+    fs::create_directories(m_destination.parent_path(), err);
+    if (err.value()) {
+        spdlog::warn("Could not create parent path ({0}): {1}", m_destination.parent_path().string(), err.message());
+        return;
+    }
+    // a link would share the unrotated data with the original
+    if (file.orientation() != upright) {
+        if (copy_rotate_jpeg(file, m_destination) && reset_exif_orientation(m_destination)) {
+            return; // operation ok
+        }
+        spdlog::warn("Fallback to regular link operation for {}", file.path().string());
+    }
+    linkFile(file);
+}
+
+auto FileOperationLinkJpeg::visit(const FileInfoImage& file) -> void
+{
+    linkFile(file);
+}
+
+auto FileOperationLinkJpeg::visit(const FileInfoImageJpeg& file) -> void
+{
+    linkFileJpeg(file);
+}
+
+auto FileOperationLinkJpeg::visit(const FileInfoVideo& file) -> void
+{
+    linkFile(file);
+}
+
+} // namespace mediacopier
@@ -16,6 +16,8 @@
 
 #include <mediacopier/operation_move.hpp>
 
+#include <mediacopier/copy_engine.hpp>
+#include <mediacopier/copy_verifier.hpp>
 #include <mediacopier/error.hpp>
 #include <mediacopier/file_info_image_jpeg.hpp>
 #include <mediacopier/file_info_video.hpp>
@@ -32,13 +34,19 @@ auto FileOperationMove::moveFile(const AbstractFileInfo& file) const -> void
     fs::rename(file.path(), m_destination, err);
     if (err.value() == EXDEV) {
         spdlog::debug("Move accross filesystems, fallback to copy + remove approach");
-        fs::copy_file(file.path(), m_destination, fs::copy_options::overwrite_existing); // may throw
+        if (m_verifier != nullptr) {
+            m_verifier->copy(file.path(), m_destination); // may throw, the original is kept then
+        } else {
+            fast_copy(file.path(), m_destination); // may throw
+        }
         fs::remove(file.path(), err);
         if (err) {
             spdlog::warn("Failed to remove the original file: ({0}): {1}", file.path().string(), err.message());
         }
     } else if (err) {
         throw mediacopier::FileOperationError { "Failed to move file " + file.path().string() + ": " + err.message() };
+    } else if (m_verifier != nullptr) {
+        m_verifier->record(m_destination); // renamed, the data didn't move
     }
 }
 
@@ -16,6 +16,7 @@
 
 #include <mediacopier/operation_move_jpeg.hpp>
 
+#include <mediacopier/copy_verifier.hpp>
 #include <mediacopier/file_info_video.hpp>
 #include <mediacopier/operation_copy_jpeg.hpp>
 #include <spdlog/spdlog.h>
@@ -35,6 +36,9 @@ auto FileOperationMoveJpeg::moveFileJpeg(const FileInfoImageJpeg& file) const ->
         return;
     }
     if (file.orientation() != upright && copy_rotate_jpeg(file, m_destination) && reset_exif_orientation(m_destination)) {
+        if (m_verifier != nullptr) {
+            m_verifier->record(m_destination); // also makes sure it is on the disk before the original is removed
+        }
         fs::remove(file.path(), err);
         if (err) {
             spdlog::warn("Failed to remove the original file: ({0}): {1}", file.path().string(), err.message());
@@ -0,0 +1,105 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/path_table.hpp>
+
+#include <mediacopier/error.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+constexpr static const size_t BLOCK_SIZE = 64 * 1024;
+
+namespace mediacopier {
+
+auto PathTable::intern(const std::filesystem::path& path) -> Handle
+{
+    const auto directory = path.parent_path().string();
+    const auto filename = path.filename().string();
+
+    auto dir = m_directoryIds.find(directory);
+    if (dir == m_directoryIds.end()) {
+        if (m_directories.size() == std::numeric_limits<uint32_t>::max()) {
+            throw MediaCopierError { "Too many directories" };
+        }
+        const auto id = static_cast<uint32_t>(m_directories.size());
+        m_directories.push_back({ store(directory), {} });
+        dir = m_directoryIds.emplace(m_directories.back().path, id).first;
+    }
+
+    auto& files = m_directories[dir->second].files;
+    if (const auto file = files.find(filename); file != files.end()) {
+        return file->second;
+    }
+    if (m_entries.size() == std::numeric_limits<Handle>::max()) {
+        throw MediaCopierError { "Too many paths" };
+    }
+    const auto handle = static_cast<Handle>(m_entries.size());
+    m_entries.push_back({ dir->second, store(filename) });
+    files.emplace(m_entries.back().filename, handle);
+    return handle;
+}
+
+auto PathTable::find(const std::filesystem::path& path) const -> std::optional<Handle>
+{
+    const auto dir = m_directoryIds.find(path.parent_path().string());
+    if (dir == m_directoryIds.end()) {
+        return {};
+    }
+    const auto& files = m_directories[dir->second].files;
+    const auto file = files.find(path.filename().string());
+    if (file == files.end()) {
+        return {};
+    }
+    return { file->second };
+}
+
+auto PathTable::path(Handle handle) const -> std::filesystem::path
+{
+    const auto& entry = m_entries.at(handle);
+    return std::filesystem::path { m_directories[entry.directory].path } / entry.filename;
+}
+
+auto PathTable::directory(Handle handle) const -> std::string_view
+{
+    return m_directories[m_entries.at(handle).directory].path;
+}
+
+auto PathTable::filename(Handle handle) const -> std::string_view
+{
+    return m_entries.at(handle).filename;
+}
+
+auto PathTable::store(std::string_view value) -> std::string_view
+{
+    if (value.empty()) {
+        return {};
+    }
+    if (value.size() > m_blockFree) {
+        const auto size = std::max(BLOCK_SIZE, value.size());
+        m_blocks.push_back(std::make_unique<char[]>(size));
+        m_cursor = m_blocks.back().get();
+        m_blockFree = size;
+    }
+    std::memcpy(m_cursor, value.data(), value.size());
+    const std::string_view result { m_cursor, value.size() };
+    m_cursor += value.size();
+    m_blockFree -= value.size();
+    return result;
+}
+
+} // namespace mediacopier
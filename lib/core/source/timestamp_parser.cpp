@@ -0,0 +1,180 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <mediacopier/timestamp_parser.hpp>
+
+#include <cstdint>
+
+namespace {
+
+using namespace std::chrono;
+
+constexpr static const size_t DATE_TIME_LENGTH = 19;
+constexpr static const size_t MAX_FRACTION_DIGITS = 9;
+
+auto is_digit(char c) noexcept -> bool
+{
+    return c >= '0' && c <= '9';
+}
+
+// reads `count` digits at `pos`
+auto read_number(std::string_view value, size_t pos, size_t count, int& result) noexcept -> bool
+{
+    if (pos + count > value.size()) {
+        return false;
+    }
+    result = 0;
+    for (size_t i = pos; i < pos + count; ++i) {
+        if (!is_digit(value[i])) {
+            return false;
+        }
+        result = result * 10 + (value[i] - '0');
+    }
+    return true;
+}
+
+auto read_date_time(std::string_view value, char dateSeparator, char separator) noexcept -> std::optional<system_clock::time_point>
+{
+    int y = 0, m = 0, d = 0, hh = 0, mm = 0, ss = 0;
+    if (value.size() < DATE_TIME_LENGTH
+        || !read_number(value, 0, 4, y) || value[4] != dateSeparator
+        || !read_number(value, 5, 2, m) || value[7] != dateSeparator
+        || !read_number(value, 8, 2, d) || value[10] != separator
+        || !read_number(value, 11, 2, hh) || value[13] != ':'
+        || !read_number(value, 14, 2, mm) || value[16] != ':'
+        || !read_number(value, 17, 2, ss)) {
+        return {};
+    }
+    const year_month_day date { year { y }, month { static_cast<unsigned>(m) }, day { static_cast<unsigned>(d) } };
+    if (!date.ok() || hh > 23 || mm > 59 || ss > 59) {
+        return {};
+    }
+    return { sys_days { date } + hours { hh } + minutes { mm } + seconds { ss } };
+}
+
+// reads digits up to the end of the value or the first non digit, which is returned as `pos`
+auto read_fraction(std::string_view value, size_t& pos) noexcept -> std::optional<system_clock::duration>
+{
+    int64_t fraction = 0;
+    size_t count = 0;
+    for (; pos < value.size() && is_digit(value[pos]); ++pos, ++count) {
+        if (count == MAX_FRACTION_DIGITS) {
+            return {};
+        }
+        fraction = fraction * 10 + (value[pos] - '0');
+    }
+    if (count == 0) {
+        return {};
+    }
+    for (; count < MAX_FRACTION_DIGITS; ++count) {
+        fraction *= 10;
+    }
+    return { duration_cast<system_clock::duration>(nanoseconds { fraction }) };
+}
+
+// '+HH', '+HHMM' or '+HH:MM', the colon is mandatory in exif
+auto read_offset(std::string_view value, bool colonRequired) noexcept -> std::optional<minutes>
+{
+    int hh = 0, mm = 0;
+    if ((value.size() != 3 && value.size() != 5 && value.size() != 6) || (value[0] != '+' && value[0] != '-')
+        || !read_number(value, 1, 2, hh)) {
+        return {};
+    }
+    if (value.size() == 6) {
+        if (value[3] != ':' || !read_number(value, 4, 2, mm)) {
+            return {};
+        }
+    } else if (colonRequired || (value.size() == 5 && !read_number(value, 3, 2, mm))) {
+        return {};
+    }
+    if (hh > 23 || mm > 59) {
+        return {};
+    }
+    const minutes offset = hours { hh } + minutes { mm };
+    return { value[0] == '-' ? -offset : offset };
+}
+
+} // namespace
+
+namespace mediacopier {
+
+auto parse_exif_timestamp(std::string_view dateTime, std::string_view subSec) noexcept -> std::optional<system_clock::time_point>
+{
+    auto result = read_date_time(dateTime, ':', ' ');
+    if (!result.has_value()) {
+        return {};
+    }
+    size_t pos = DATE_TIME_LENGTH;
+    if (pos < dateTime.size()) {
+        // sub seconds within the date time value take precedence
+        if (dateTime[pos] != '.') {
+            return {};
+        }
+        const auto fraction = read_fraction(dateTime, ++pos);
+        if (!fraction.has_value() || pos != dateTime.size()) {
+            return {};
+        }
+        return { result.value() + fraction.value() };
+    }
+
+    // some cameras pad the sub seconds with spaces
+    while (!subSec.empty() && (subSec.back() == ' ' || subSec.back() == '\0')) {
+        subSec.remove_suffix(1);
+    }
+    if (!subSec.empty()) {
+        pos = 0;
+        const auto fraction = read_fraction(subSec, pos);
+        if (!fraction.has_value() || pos != subSec.size()) {
+            return {};
+        }
+        return { result.value() + fraction.value() };
+    }
+    return result;
+}
+
+auto parse_utc_offset(std::string_view offset) noexcept -> std::optional<minutes>
+{
+    return read_offset(offset, true);
+}
+
+auto parse_iso_timestamp(std::string_view timestamp) noexcept -> std::optional<IsoTimestamp>
+{
+    const auto local = read_date_time(timestamp, '-', 'T');
+    if (!local.has_value()) {
+        return {};
+    }
+    IsoTimestamp result { local.value(), std::nullopt };
+    size_t pos = DATE_TIME_LENGTH;
+    if (pos < timestamp.size() && timestamp[pos] == '.') {
+        const auto fraction = read_fraction(timestamp, ++pos);
+        if (!fraction.has_value()) {
+            return {};
+        }
+        result.local += fraction.value();
+    }
+    const auto zone = timestamp.substr(pos);
+    if (zone == "Z") {
+        result.offset = minutes::zero();
+    } else if (!zone.empty()) {
+        result.offset = read_offset(zone, false);
+        if (!result.offset.has_value()) {
+            return {};
+        }
+    }
+    return { result };
+}
+
+} // namespace mediacopier
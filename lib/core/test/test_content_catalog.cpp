@@ -0,0 +1,111 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/content_catalog.hpp>
+#include <mediacopier/file_info_video.hpp>
+#include <mediacopier/file_register.hpp>
+
+#include <fstream>
+
+namespace mediacopier::test {
+
+class ContentCatalogTests : public CommonTestFixtures {
+protected:
+    auto write(const fs::path& path, const std::string& content) const -> fs::path
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream output { path };
+        output << content;
+        return path;
+    }
+};
+
+TEST_F(ContentCatalogTests, storesRecords)
+{
+    const ContentHash kept { 1, 2 };
+    const ContentHash missing { 3, 4 };
+    write(workdir() / "2019" / "kept.jpg", "kept");
+    {
+        ContentCatalog catalog { workdir() };
+        catalog.add(kept, { 4, 5, "2019/kept.jpg", true });
+        catalog.add(missing, { 4, 6, "2019/missing.jpg", true });
+        ASSERT_TRUE(catalog.containsSize(4));
+        ASSERT_EQ(catalog.size(), 2);
+        catalog.store();
+    }
+
+    ContentCatalog catalog { workdir() };
+    ASSERT_EQ(catalog.size(), 1);
+    ASSERT_EQ(catalog.find(missing), nullptr);
+    ASSERT_NE(catalog.find(kept), nullptr);
+    ASSERT_EQ(catalog.find(kept)->timestamp, 5);
+    ASSERT_EQ(catalog.find(kept)->destination, "2019/kept.jpg");
+
+    catalog.remove(kept);
+    ASSERT_FALSE(catalog.containsSize(4));
+}
+
+TEST_F(ContentCatalogTests, recognizesImportedFiles)
+{
+    const auto dstdir = workdir() / "dst";
+    const auto src1 = write(workdir() / "test1.mp4", "same");
+    const auto src2 = write(workdir() / "test2.mp4", "same");
+    const Timestamp timestamp1 { std::chrono::sys_days { std::chrono::year { 2019 } / 2 / 5 } };
+    const Timestamp timestamp2 { std::chrono::sys_days { std::chrono::year { 2020 } / 2 / 5 } };
+    {
+        FileRegister dst { dstdir, "%Y/%Y%m%d", false };
+        const auto path = dst.add(FileInfoVideo { src1, timestamp1 });
+        ASSERT_TRUE(path.has_value());
+        fs::create_directories(path->parent_path());
+        fs::copy_file(src1, path.value());
+        dst.store();
+    }
+
+    // same content with another timestamp, ends up with another name
+    FileRegister dst { dstdir, "%Y/%Y%m%d", false };
+    ASSERT_FALSE(dst.add(FileInfoVideo { src2, timestamp2 }).has_value());
+
+    // removed from the library, imported again
+    fs::remove_all(dstdir / "2019");
+    FileRegister next { dstdir, "%Y/%Y%m%d", false };
+    ASSERT_TRUE(next.add(FileInfoVideo { src2, timestamp2 }).has_value());
+}
+
+TEST_F(ContentCatalogTests, catalogsWrittenFilesOnly)
+{
+    const auto dstdir = workdir() / "dst";
+    const auto src1 = write(workdir() / "test1.mp4", "written");
+    const auto src2 = write(workdir() / "test2.mp4", "skipped");
+    const Timestamp timestamp1 { std::chrono::sys_days { std::chrono::year { 2019 } / 2 / 5 } };
+    const Timestamp timestamp2 { std::chrono::sys_days { std::chrono::year { 2020 } / 2 / 5 } };
+    {
+        FileRegister dst { dstdir, "%Y/%Y%m%d", false };
+        const auto path = dst.add(FileInfoVideo { src1, timestamp1 });
+        ASSERT_TRUE(path.has_value());
+        ASSERT_TRUE(dst.add(FileInfoVideo { src2, timestamp2 }).has_value());
+        fs::create_directories(path->parent_path());
+        fs::copy_file(src1, path.value());
+        dst.store();
+    }
+
+    ContentCatalog catalog { dstdir };
+    ASSERT_EQ(catalog.size(), 1);
+    ASSERT_TRUE(catalog.containsSize(fs::file_size(src1)));
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,73 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/copy_engine.hpp>
+#include <mediacopier/error.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace mediacopier::test {
+
+class CopyEngineTests : public CommonTestFixtures {
+protected:
+    static auto read(const fs::path& path) -> std::string
+    {
+        std::ifstream input { path, std::ios_base::in | std::ios_base::binary };
+        return { std::istreambuf_iterator<char> { input }, std::istreambuf_iterator<char> {} };
+    }
+    auto write(const std::string& name, const std::string& content) const -> fs::path
+    {
+        const auto path = workdir() / name;
+        std::ofstream output { path, std::ios_base::out | std::ios_base::binary };
+        output.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return path;
+    }
+};
+
+TEST_F(CopyEngineTests, copiesContentAndPermissions)
+{
+    std::string content;
+    for (size_t i = 0; i < 3 * 1024 * 1024 + 17; ++i) {
+        content.push_back(static_cast<char>(i * 31 % 251));
+    }
+    const auto source = write("source.mp4", content);
+    fs::permissions(source, fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read);
+    const auto destination = write("destination.mp4", "existing content that is replaced");
+
+    copy_stats().reset();
+    const auto method = fast_copy(source, destination);
+    ASSERT_EQ(read(destination), content);
+    ASSERT_EQ(fs::status(destination).permissions(), fs::status(source).permissions());
+
+    const auto counter = copy_stats().get(method);
+    ASSERT_EQ(counter.files, 1);
+    ASSERT_EQ(counter.bytes, content.size());
+}
+
+TEST_F(CopyEngineTests, rejectsInvalidFiles)
+{
+    const auto source = write("source.mp4", "content");
+    ASSERT_THROW(fast_copy(workdir() / "missing.mp4", workdir() / "destination.mp4"), FileOperationError);
+    ASSERT_THROW(fast_copy(source, source), FileOperationError);
+    ASSERT_EQ(read(source), "content");
+    ASSERT_THROW(fast_copy(source, workdir() / "missing" / "destination.mp4"), FileOperationError);
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,87 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/copy_executor.hpp>
+#include <mediacopier/error.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+
+namespace mediacopier::test {
+
+class CopyExecutorTests : public CommonTestFixtures {
+protected:
+    static auto read(const fs::path& path) -> std::string
+    {
+        std::ifstream input { path, std::ios_base::in | std::ios_base::binary };
+        return { std::istreambuf_iterator<char> { input }, std::istreambuf_iterator<char> {} };
+    }
+    static auto content(size_t index) -> std::string
+    {
+        // empty, small and files spanning several buffers
+        std::string result(index % 3 == 0 ? 0 : index * (index % 3 == 1 ? 97 : 131071), '\0');
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = static_cast<char>((i + index) * 31 % 251);
+        }
+        return result;
+    }
+};
+
+TEST_F(CopyExecutorTests, copiesAllFiles)
+{
+    constexpr const size_t count = 24;
+    for (size_t i = 0; i < count; ++i) {
+        const auto data = content(i);
+        std::ofstream output { workdir() / ("src" + std::to_string(i)), std::ios_base::out | std::ios_base::binary };
+        output.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    CopyExecutor executor { 4 };
+    std::set<uint64_t> tags;
+    for (size_t i = 0; i < count; ++i) {
+        executor.submit({ workdir() / ("src" + std::to_string(i)), workdir() / "dst" / std::to_string(i) / "file", i });
+        for (const auto& completion : executor.poll()) {
+            ASSERT_EQ(completion.error, nullptr);
+            tags.insert(completion.job.tag);
+        }
+    }
+    for (const auto& completion : executor.drain()) {
+        ASSERT_EQ(completion.error, nullptr);
+        tags.insert(completion.job.tag);
+    }
+    ASSERT_EQ(tags.size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(read(workdir() / "dst" / std::to_string(i) / "file"), content(i));
+    }
+}
+
+TEST_F(CopyExecutorTests, reportsFailedCopies)
+{
+    CopyExecutor executor;
+    executor.submit({ workdir() / "missing.jpg", workdir() / "dst" / "missing.jpg", 7 });
+    const auto completions = executor.drain();
+    ASSERT_EQ(completions.size(), 1);
+    ASSERT_EQ(completions.front().job.tag, 7);
+    ASSERT_THROW(std::rethrow_exception(completions.front().error), FileOperationError);
+    ASSERT_FALSE(fs::exists(workdir() / "dst" / "missing.jpg"));
+    ASSERT_TRUE(executor.drain().empty());
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,112 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/content_hash.hpp>
+#include <mediacopier/copy_executor.hpp>
+#include <mediacopier/copy_verifier.hpp>
+#include <mediacopier/error.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace mediacopier::test {
+
+class CopyVerifierTests : public CommonTestFixtures {
+protected:
+    static auto read(const fs::path& path) -> std::string
+    {
+        std::ifstream input { path, std::ios_base::in | std::ios_base::binary };
+        return { std::istreambuf_iterator<char> { input }, std::istreambuf_iterator<char> {} };
+    }
+    auto write(const std::string& name, const std::string& content) const -> fs::path
+    {
+        const auto path = workdir() / name;
+        std::ofstream output { path, std::ios_base::out | std::ios_base::binary };
+        output.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return path;
+    }
+    static auto sha256(const std::string& data, size_t step) -> std::string
+    {
+        Sha256Hasher hasher;
+        for (size_t i = 0; i < data.size(); i += step) {
+            hasher.update({ reinterpret_cast<const uint8_t*>(data.data()) + i, std::min(step, data.size() - i) });
+        }
+        return to_hex(hasher.finish());
+    }
+};
+
+TEST_F(CopyVerifierTests, hashesLikeSha256sum)
+{
+    ASSERT_EQ(sha256("", 1), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    ASSERT_EQ(sha256("abc", 1), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    ASSERT_EQ(sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 5), "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    ASSERT_EQ(sha256(std::string(1000000, 'a'), 997), "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST_F(CopyVerifierTests, writesManifest)
+{
+    const auto destination = workdir() / "dst";
+    fs::create_directories(destination / "2019");
+    const auto first = write("first.jpg", "abc");
+    const auto second = write("second.jpg", std::string(3 * 1024 * 1024 + 5, 'a'));
+
+    CopyVerifier verifier { destination };
+    verifier.copy(first, destination / "2019" / "first copy.jpg");
+    verifier.copy(second, destination / "back\\slash.jpg");
+    verifier.copy(first, destination / "removed.jpg");
+    ASSERT_EQ(read(destination / "back\\slash.jpg"), read(second));
+
+    fs::remove(destination / "removed.jpg");
+    verifier.store();
+    verifier.store(); // nothing new, the manifest stays the same
+    ASSERT_EQ(read(destination / CopyVerifier::MANIFEST_NAME),
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad  2019/first copy.jpg\n"
+        "\\"
+            + sha256(read(second), 4096) + "  back\\\\slash.jpg\n");
+
+    // imported again with another content, the old checksum is replaced
+    CopyVerifier reimport { destination };
+    reimport.copy(second, destination / "2019" / "first copy.jpg");
+    reimport.store();
+    ASSERT_EQ(read(destination / CopyVerifier::MANIFEST_NAME),
+        "\\"
+            + sha256(read(second), 4096) + "  back\\\\slash.jpg\n"
+            + sha256(read(second), 4096) + "  2019/first copy.jpg\n");
+}
+
+TEST_F(CopyVerifierTests, verifiesExecutorCopies)
+{
+    const auto source = write("source.mp4", std::string(2 * 1024 * 1024, 'x'));
+    CopyVerifier verifier { workdir() };
+    CopyExecutor executor { 2, {}, &verifier };
+    executor.submit({ source, workdir() / "dst" / "copy.mp4", 1 });
+    executor.submit({ workdir() / "missing.mp4", workdir() / "dst" / "missing.mp4", 2 });
+
+    auto completions = executor.drain();
+    ASSERT_EQ(completions.size(), 2);
+    std::sort(completions.begin(), completions.end(), [](const auto& a, const auto& b) { return a.job.tag < b.job.tag; });
+    ASSERT_EQ(completions[0].error, nullptr);
+    ASSERT_THROW(std::rethrow_exception(completions[1].error), FileOperationError);
+
+    verifier.store();
+    ASSERT_EQ(read(workdir() / CopyVerifier::MANIFEST_NAME), sha256(read(source), 1024) + "  dst/copy.mp4\n");
+}
+
+} // namespace mediacopier::test
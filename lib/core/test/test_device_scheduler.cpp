@@ -0,0 +1,62 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/device_scheduler.hpp>
+
+namespace mediacopier::test {
+
+class DeviceSchedulerTests : public CommonTestFixtures {
+};
+
+TEST_F(DeviceSchedulerTests, limitsCopiesPerDevice)
+{
+    DeviceScheduler scheduler { { 2, 2, 2, 1024 } };
+    const auto source = workdir() / "source.jpg";
+    const auto destination = workdir() / "missing" / "destination.jpg";
+
+    const auto first = scheduler.tryAcquire(source, destination, 10);
+    const auto second = scheduler.tryAcquire(source, destination, 10);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    ASSERT_EQ(first->source, first->destination);
+    ASSERT_FALSE(scheduler.tryAcquire(source, destination, 10).has_value());
+
+    scheduler.release(first.value());
+    ASSERT_TRUE(scheduler.tryAcquire(source, destination, 10).has_value());
+    ASSERT_EQ(scheduler.inFlightBytes(), 20);
+}
+
+TEST_F(DeviceSchedulerTests, limitsBytesInFlight)
+{
+    DeviceScheduler scheduler { { 8, 8, 8, 100 } };
+    const auto source = workdir() / "source.mp4";
+
+    // the first copy is admitted no matter how large it is
+    const auto large = scheduler.tryAcquire(source, source, 200);
+    ASSERT_TRUE(large.has_value());
+    ASSERT_FALSE(scheduler.tryAcquire(source, source, 1).has_value());
+
+    scheduler.release(large.value());
+    const auto small = scheduler.tryAcquire(source, source, 60);
+    ASSERT_TRUE(small.has_value());
+    ASSERT_TRUE(scheduler.tryAcquire(source, source, 40).has_value());
+    ASSERT_FALSE(scheduler.tryAcquire(source, source, 1).has_value());
+    ASSERT_EQ(scheduler.inFlightBytes(), 100);
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,90 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/directory_walker.hpp>
+
+#include <fstream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace mediacopier::test {
+
+class DirectoryWalkerTests : public CommonTestFixtures {
+public:
+    auto touch(const fs::path& path) const
+    {
+        fs::create_directories(path.parent_path());
+        std::ofstream output(path);
+        output << "test";
+    }
+};
+
+TEST_F(DirectoryWalkerTests, findsAllRegularFiles)
+{
+    std::set<fs::path> expected;
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < 16; ++j) {
+            const auto path = workdir() / std::to_string(i) / "sub" / std::to_string(j) / "file.jpg";
+            touch(path);
+            expected.insert(path);
+        }
+    }
+    fs::create_directories(workdir() / "empty");
+    fs::create_symlink(workdir() / "0", workdir() / "link-to-dir");
+    fs::create_symlink(workdir() / "0" / "sub" / "0" / "file.jpg", workdir() / "link-to-file.jpg");
+    expected.insert(workdir() / "link-to-file.jpg");
+
+    std::set<fs::path> result;
+    DirectoryWalker walker { workdir(), true, 4, 3 };
+    for (const auto& entry : walker) {
+        ASSERT_TRUE(result.insert(entry.path).second);
+        ASSERT_EQ(entry.size, 4);
+    }
+    ASSERT_EQ(result, expected);
+
+    const auto progress = walker.progress();
+    ASSERT_TRUE(progress.complete);
+    ASSERT_EQ(progress.files, expected.size());
+}
+
+TEST_F(DirectoryWalkerTests, earlyCancel)
+{
+    for (size_t i = 0; i < 64; ++i) {
+        touch(workdir() / std::to_string(i % 4) / (std::to_string(i) + ".jpg"));
+    }
+    DirectoryWalker walker { workdir(), false, 2, 1 };
+    ASSERT_TRUE(walker.next().has_value());
+    walker.cancel();
+    ASSERT_FALSE(walker.next().has_value());
+}
+
+TEST_F(DirectoryWalkerTests, missingRoot)
+{
+    ASSERT_THROW(DirectoryWalker { workdir() / "missing" }, fs::filesystem_error);
+
+    touch(workdir() / "file.jpg");
+    ASSERT_THROW(DirectoryWalker { workdir() / "file.jpg" }, fs::filesystem_error);
+
+    DirectoryWalker walker { workdir() };
+    const auto file = walker.next();
+    ASSERT_TRUE(file.has_value());
+    ASSERT_EQ(file->path, workdir() / "file.jpg");
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,72 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifdef __linux__
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/directory_watcher.hpp>
+
+#include <fstream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+using namespace std::chrono_literals;
+
+namespace mediacopier::test {
+
+class DirectoryWatcherTests : public CommonTestFixtures {
+public:
+    static auto collect(DirectoryWatcher& watcher, size_t count) -> std::set<fs::path>
+    {
+        std::set<fs::path> result;
+        for (size_t i = 0; i < 100 && result.size() < count; ++i) {
+            for (auto& path : watcher.poll(50ms)) {
+                result.insert(std::move(path));
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(DirectoryWatcherTests, reportsWrittenFiles)
+{
+    std::ofstream { workdir() / "existing.jpg" } << "test";
+    DirectoryWatcher watcher { workdir(), 100ms };
+
+    // files that are still open must not be reported
+    std::ofstream output { workdir() / "a.jpg" };
+    output << "test" << std::flush;
+    ASSERT_TRUE(watcher.poll(200ms).empty());
+    output.close();
+
+    fs::create_directories(workdir() / "sub" / "dir");
+    std::ofstream { workdir() / "sub" / "dir" / "b.jpg" } << "test";
+    std::ofstream { workdir() / "c.tmp" } << "test";
+    fs::rename(workdir() / "c.tmp", workdir() / "sub" / "c.jpg");
+
+    const std::set<fs::path> expected {
+        workdir() / "a.jpg",
+        workdir() / "sub" / "dir" / "b.jpg",
+        workdir() / "sub" / "c.jpg",
+    };
+    ASSERT_EQ(collect(watcher, expected.size()), expected);
+}
+
+} // namespace mediacopier::test
+
+#endif
@@ -0,0 +1,149 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/duplicate_index.hpp>
+#include <mediacopier/error.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace mediacopier::test {
+
+using namespace std::string_literals;
+
+class DuplicateIndexTests : public CommonTestFixtures {
+protected:
+    auto write(const std::string& name, const std::string& content) const -> fs::path
+    {
+        const auto path = workdir() / name;
+        std::ofstream output { path, std::ios_base::out | std::ios_base::binary };
+        output.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return path;
+    }
+    static auto jpeg(const std::string& app1, const std::string& scan) -> std::string
+    {
+        const auto length = app1.size() + 2;
+        return "\xFF\xD8\xFF\xE1"s + static_cast<char>(length >> 8) + static_cast<char>(length & 0xFF) + app1
+            + "\xFF\xDA"s + scan;
+    }
+};
+
+TEST_F(DuplicateIndexTests, hashesInPieces)
+{
+    const std::string data { "The quick brown fox jumps over the lazy dog" };
+    const std::span bytes { reinterpret_cast<const uint8_t*>(data.data()), data.size() };
+
+    Murmur3Hasher whole;
+    whole.update(bytes);
+    const auto expected = whole.finish();
+    ASSERT_NE(expected, ContentHash {});
+
+    for (size_t split = 0; split <= bytes.size(); ++split) {
+        Murmur3Hasher pieces;
+        pieces.update(bytes.subspan(0, split));
+        pieces.update(bytes.subspan(split));
+        ASSERT_EQ(pieces.finish(), expected);
+    }
+    ASSERT_EQ(Murmur3Hasher {}.finish(), ContentHash {});
+}
+
+TEST_F(DuplicateIndexTests, skipsJpegMetadata)
+{
+    const auto path = write("test.jpg", jpeg("Exif", "scan"));
+    const auto payload = locate_payload(path);
+    ASSERT_TRUE(payload.has_value());
+    ASSERT_EQ(payload->offset, 12);
+    ASSERT_EQ(payload->size, 4);
+
+    const auto other = write("test.mp4", "scan");
+    ASSERT_EQ(locate_payload(other)->offset, 0);
+    ASSERT_EQ(hash_payload(path, payload.value()), hash_payload(other, locate_payload(other).value()));
+    ASSERT_FALSE(locate_payload(workdir() / "missing.jpg").has_value());
+}
+
+TEST_F(DuplicateIndexTests, findsSamePayload)
+{
+    const auto file1 = write("test1.jpg", jpeg("Exif, orientation 1", std::string(8192, 'a') + "b"));
+    const auto file2 = write("test2.jpg", jpeg("Exif, orientation 8", std::string(8192, 'a') + "b"));
+    const auto file3 = write("test3.jpg", jpeg("Exif", std::string(8192, 'a') + "c"));
+
+    DuplicateIndex index;
+    ASSERT_FALSE(index.find(file1).has_value());
+    index.add(file1);
+    ASSERT_FALSE(index.find(file1).has_value());
+    ASSERT_EQ(index.find(file2), file1);
+    ASSERT_FALSE(index.find(file3).has_value());
+
+    ASSERT_TRUE(index.same(file1, file2));
+    // same size and prefix, still different
+    ASSERT_FALSE(index.same(file1, file3));
+    ASSERT_THROW(index.same(file1, workdir() / "missing.jpg"), MediaCopierError);
+
+    index.remove(file1);
+    ASSERT_FALSE(index.find(file2).has_value());
+
+    index.add(file1);
+    index.clear();
+    ASSERT_FALSE(index.find(file2).has_value());
+}
+
+TEST_F(DuplicateIndexTests, comparesWithinBudget)
+{
+    const auto file1 = write("test1.jpg", jpeg("Exif, orientation 1", std::string(8192, 'a') + "b"));
+    const auto file2 = write("test2.jpg", jpeg("Exif", std::string(8192, 'a') + "c"));
+    const auto file3 = write("test3.jpg", jpeg("Exif", std::string(8192, 'a')));
+
+    ASSERT_TRUE(is_duplicate(file1, file2));
+    ASSERT_FALSE(is_duplicate(file1, file2, FULL_COMPARE));
+    ASSERT_TRUE(is_duplicate(file1, file1, FULL_COMPARE));
+    ASSERT_FALSE(is_duplicate(file1, file3, FULL_COMPARE));
+    ASSERT_FALSE(is_duplicate(file1, file2, 8193));
+    ASSERT_THROW(is_duplicate(file1, workdir() / "missing.jpg"), std::runtime_error);
+}
+
+TEST_F(DuplicateIndexTests, comparesEmptyPayloads)
+{
+    const auto file1 = write("test1.mp4", "");
+    const auto file2 = write("test2.mp4", "");
+    const auto file3 = write("test3.mp4", "");
+
+    ASSERT_TRUE(is_duplicate(file1, file2));
+    ASSERT_TRUE(is_duplicate(file1, file3, FULL_COMPARE));
+
+    DuplicateIndex index { FULL_COMPARE };
+    index.add(file1);
+    ASSERT_EQ(index.find(file2), file1);
+    ASSERT_TRUE(index.same(file2, file3));
+}
+
+TEST_F(DuplicateIndexTests, comparesMatchingHashes)
+{
+    const auto file1 = write("test1.jpg", jpeg("Exif, orientation 1", std::string(8192, 'a') + "b"));
+    const auto file2 = write("test2.jpg", jpeg("Exif, orientation 8", std::string(8192, 'a') + "b"));
+
+    DuplicateIndex index { FULL_COMPARE };
+    index.add(file1);
+    ASSERT_EQ(index.find(file2), file1);
+    ASSERT_TRUE(index.same(file1, file2));
+
+    // a file that is gone since it was hashed is not reported
+    fs::remove(file1);
+    ASSERT_FALSE(index.find(file2).has_value());
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,98 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/ebml_reader.hpp>
+
+#include <fstream>
+#include <string>
+
+namespace mediacopier::test {
+
+using namespace std::string_literals;
+
+class EbmlReaderTests : public CommonTestFixtures {
+protected:
+    // ids are written with their length marker, sizes use a single byte
+    static auto element(std::string_view id, const std::string& payload) -> std::string
+    {
+        return std::string { id } + static_cast<char>(0x80 | payload.size()) + payload;
+    }
+    static auto file(const std::string& tags) -> std::string
+    {
+        // 2019-02-05T12:10:32.5Z in nanoseconds since 2001
+        const std::string date { "\x07\xEC\xD1\x58\xE5\x16\x95\x00", 8 };
+        const auto info = element("\x2A\xD7\xB1", "\x0F\x42\x40"s) + element("\x44\x61", date);
+        const auto ebml = element("\x42\x82", "matroska");
+
+        // segment and cluster of unknown size, like written by live recorders
+        const std::string unknownSize { "\x01\xFF\xFF\xFF\xFF\xFF\xFF\xFF", 8 };
+        return element("\x1A\x45\xDF\xA3", ebml)
+            + "\x18\x53\x80\x67"s + unknownSize
+            + element("\x11\x4D\x9B\x74", std::string(16, '\0'))
+            + element("\x15\x49\xA9\x66", info)
+            + tags
+            + "\x1F\x43\xB6\x75"s + unknownSize + std::string(1024 * 1024, '\0');
+    }
+    auto write(const std::string& content) const -> std::filesystem::path
+    {
+        const auto path = workdir() / "test.mkv";
+        std::ofstream output { path, std::ios_base::out | std::ios_base::binary };
+        output.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return path;
+    }
+};
+
+TEST_F(EbmlReaderTests, readsDateUtc)
+{
+    FileSource source { write(file("")) };
+    ASSERT_EQ(read_matroska_creation_time(source), "2019-02-05T12:10:32.500000Z");
+    ASSERT_LE(source.bytesRead(), FileSource::BLOCK_SIZE);
+
+    // missing segment
+    FileSource invalid { write(element("\x1A\x45\xDF\xA3", "")) };
+    ASSERT_FALSE(read_matroska_creation_time(invalid).has_value());
+}
+
+TEST_F(EbmlReaderTests, prefersGlobalTags)
+{
+    const auto& tag = [](const std::string& targets) {
+        const auto name = element("\x45\xA3", "CREATION_TIME");
+        const auto value = element("\x44\x87", "2020-01-01T00:00:00.000000Z");
+        return element("\x73\x73", element("\x63\xC0", targets) + element("\x67\xC8", name + value));
+    };
+
+    FileSource global { write(file(element("\x12\x54\xC3\x67", tag("")))) };
+    ASSERT_EQ(read_matroska_creation_time(global), "2020-01-01T00:00:00.000000Z");
+
+    FileSource track { write(file(element("\x12\x54\xC3\x67", tag(element("\x63\xC5", "\x01"s))))) };
+    ASSERT_EQ(read_matroska_creation_time(track), "2019-02-05T12:10:32.500000Z");
+}
+
+TEST_F(EbmlReaderTests, noDateBeforeCluster)
+{
+    const auto tag = element("\x73\x73", element("\x67\xC8", element("\x45\xA3", "CREATION_TIME") + element("\x44\x87", "2020-01-01T00:00:00.000000Z")));
+    const auto segment = element("\x15\x49\xA9\x66", element("\x2A\xD7\xB1", "\x0F\x42\x40"s))
+        + element("\x1F\x43\xB6\x75", std::string(16, '\0'))
+        + element("\x12\x54\xC3\x67", tag);
+
+    // the tags follow the cluster, left to libav
+    FileSource source { write(element("\x1A\x45\xDF\xA3", element("\x42\x82", "matroska")) + element("\x18\x53\x80\x67", segment)) };
+    ASSERT_FALSE(read_matroska_creation_time(source).has_value());
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,156 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/exif_reader.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace mediacopier::test {
+
+class ExifBuilder {
+public:
+    explicit ExifBuilder(bool littleEndian)
+        : m_littleEndian { littleEndian }
+    {
+    }
+    auto u16(uint16_t value) -> void
+    {
+        if (m_littleEndian) {
+            m_data.push_back(static_cast<uint8_t>(value));
+            m_data.push_back(static_cast<uint8_t>(value >> 8));
+        } else {
+            m_data.push_back(static_cast<uint8_t>(value >> 8));
+            m_data.push_back(static_cast<uint8_t>(value));
+        }
+    }
+    auto u32(uint32_t value) -> void
+    {
+        if (m_littleEndian) {
+            u16(static_cast<uint16_t>(value));
+            u16(static_cast<uint16_t>(value >> 16));
+        } else {
+            u16(static_cast<uint16_t>(value >> 16));
+            u16(static_cast<uint16_t>(value));
+        }
+    }
+    auto ascii(std::string_view value) -> void
+    {
+        m_data.insert(m_data.end(), value.begin(), value.end());
+        m_data.push_back(0);
+    }
+
+    // IFD0: orientation + exif pointer, exif IFD: original date time (out of line), sub seconds (inline)
+    static auto build(bool littleEndian) -> std::vector<uint8_t>
+    {
+        ExifBuilder tiff { littleEndian };
+        tiff.m_data = littleEndian ? std::vector<uint8_t> { 'I', 'I' } : std::vector<uint8_t> { 'M', 'M' };
+        tiff.u16(42);
+        tiff.u32(8);
+        tiff.u16(2);
+        tiff.u16(0x0112), tiff.u16(3), tiff.u32(1), tiff.u16(6), tiff.u16(0);
+        tiff.u16(0x8769), tiff.u16(4), tiff.u32(1), tiff.u32(38);
+        tiff.u32(0);
+        tiff.u16(2);
+        tiff.u16(0x9003), tiff.u16(2), tiff.u32(20), tiff.u32(68);
+        tiff.u16(0x9291), tiff.u16(2), tiff.u32(4), tiff.ascii("123");
+        tiff.u32(0);
+        tiff.ascii("2019:02:05 12:10:32");
+        return tiff.m_data;
+    }
+
+private:
+    bool m_littleEndian;
+    std::vector<uint8_t> m_data;
+};
+
+class ExifReaderTests : public CommonTestFixtures {
+};
+
+TEST_F(ExifReaderTests, readsTiffStructure)
+{
+    for (const bool littleEndian : { true, false }) {
+        const auto data = ExifBuilder::build(littleEndian);
+        const auto tags = read_exif_tags(data);
+        ASSERT_TRUE(tags.has_value());
+        ASSERT_EQ(tags->orientation, 6);
+        ASSERT_EQ(tags->dateTime[0], "2019:02:05 12:10:32");
+        ASSERT_EQ(tags->subSec[0], "123");
+        ASSERT_EQ(tags->dateTime[1].data(), nullptr);
+        ASSERT_EQ(tags->dateTime[2].data(), nullptr);
+        ASSERT_EQ(tags->offset[0].data(), nullptr);
+
+        // values pointing behind the buffer must be rejected
+        ASSERT_FALSE(read_exif_tags(std::span { data }.first(data.size() - 4)).has_value());
+    }
+}
+
+TEST_F(ExifReaderTests, locatesJpegSegment)
+{
+    const auto tiff = ExifBuilder::build(true);
+    std::vector<uint8_t> jpeg { 0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x04, 0x00, 0x00 };
+    const auto length = static_cast<uint16_t>(tiff.size() + 8);
+    const std::string_view exif { "\xFF\xE1\0\0Exif\0\0", 10 };
+    jpeg.insert(jpeg.end(), exif.begin(), exif.end());
+    jpeg.at(jpeg.size() - 8) = static_cast<uint8_t>(length >> 8);
+    jpeg.at(jpeg.size() - 7) = static_cast<uint8_t>(length);
+    jpeg.insert(jpeg.end(), tiff.begin(), tiff.end());
+    jpeg.insert(jpeg.end(), { 0xFF, 0xDA });
+
+    const auto location = locate_jpeg_exif(jpeg);
+    ASSERT_TRUE(location.has_value());
+    ASSERT_EQ(location->offset, 18);
+    ASSERT_EQ(location->size, tiff.size());
+
+    // segment list is incomplete
+    ASSERT_FALSE(locate_jpeg_exif(std::span { jpeg }.first(10)).has_value());
+
+    // no exif segment before the image data
+    const std::vector<uint8_t> plain { 0xFF, 0xD8, 0xFF, 0xE0, 0x00, 0x02, 0xFF, 0xDA, 0x00, 0x00 };
+    ASSERT_EQ(locate_jpeg_exif(plain)->size, 0);
+    ASSERT_FALSE(locate_jpeg_exif(tiff).has_value());
+}
+
+TEST_F(ExifReaderTests, boundedFileReads)
+{
+    // tiff structure behind a large block of data, like previews in raw files
+    const auto tiff = ExifBuilder::build(false);
+    const auto path = workdir() / "test.raw";
+    {
+        std::ofstream output { path, std::ios_base::out | std::ios_base::binary };
+        const std::vector<char> padding(1024 * 1024, 0);
+        output.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        output.write(reinterpret_cast<const char*>(tiff.data()), static_cast<std::streamsize>(tiff.size()));
+        output.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    }
+
+    const std::vector<uint8_t> header(512, 0);
+    FileSource source { path, header };
+    const auto tags = read_exif_tags(source, 1024 * 1024);
+    ASSERT_TRUE(tags.has_value());
+    ASSERT_EQ(tags->dateTime[0], "2019:02:05 12:10:32");
+    ASSERT_EQ(tags->orientation, 6);
+    ASSERT_LE(source.bytesRead(), FileSource::BLOCK_SIZE);
+
+    FileSource limited { path, header, FileSource::BLOCK_SIZE - 1 };
+    ASSERT_FALSE(read_exif_tags(limited, 1024 * 1024).has_value());
+    ASSERT_TRUE(limited.read(2 * 1024 * 1024 + tiff.size(), 1).empty());
+}
+
+} // namespace mediacopier::test
@@ -92,6 +92,7 @@ TEST_F(FileInfoTests, invalidFileInfoImageDateTimeMissing)
     img.convert(workdir() / "test.jpg");
     // DateTime missing, should be invalid
     checkFileInvalid(img.path());
+    ASSERT_EQ(probe(img.path()).error().reason, ProbeError::Reason::NoMetadata);
 }
 
 TEST_F(FileInfoTests, validFileInfoVideo)
@@ -122,6 +123,30 @@ TEST_F(FileInfoTests, invalidFileInfoVideo)
     vid.dropMetadata();
     // creation_time missing, should be invalid
     checkFileInvalid(vid.path());
+    ASSERT_EQ(probe(vid.path()).error().reason, ProbeError::Reason::NoMetadata);
+}
+
+TEST_F(FileInfoTests, fileTypeSignatures)
+{
+    static auto detect = [](std::string_view magic) -> FileType {
+        std::vector<uint8_t> header(magic.begin(), magic.end());
+        header.resize(512);
+        return detect_file_type(header);
+    };
+    ASSERT_EQ(detect("\xFF\xD8\xFF\xE1"), FileType::Jpeg);
+    ASSERT_EQ(detect(std::string_view { "II*\0", 4 }), FileType::Tiff);
+    ASSERT_EQ(detect(std::string_view { "MM\0*", 4 }), FileType::Tiff);
+    ASSERT_EQ(detect(std::string_view { "\0\0\0\x18" "ftypheic", 12 }), FileType::Heif);
+    ASSERT_EQ(detect(std::string_view { "\0\0\0\x18" "ftypisom", 12 }), FileType::Isobmff);
+    ASSERT_EQ(detect("\x1A\x45\xDF\xA3"), FileType::Matroska);
+    ASSERT_EQ(detect("RIFF\x10\x10\x10\x10WEBP"), FileType::Webp);
+    ASSERT_EQ(detect("RIFF\x10\x10\x10\x10" "AVI "), FileType::Avi);
+    ASSERT_EQ(detect("Hello!"), FileType::Unknown);
+    ASSERT_EQ(detect_file_type({}), FileType::Unknown);
+
+    ASSERT_TRUE(is_image_type(FileType::Heif));
+    ASSERT_FALSE(is_image_type(FileType::Isobmff));
+    ASSERT_FALSE(is_image_type(FileType::Unknown));
 }
 
 TEST_F(FileInfoTests, unkownFileType)
@@ -132,6 +157,7 @@ TEST_F(FileInfoTests, unkownFileType)
     output.close();
     // file is neither image nor video, should be invalid
     checkFileInvalid(path);
+    ASSERT_EQ(probe(path).error().reason, ProbeError::Reason::UnknownType);
 }
 
 } // namespace mediacopier::test
@@ -20,6 +20,7 @@
 #include <mediacopier/file_info_factory.hpp>
 #include <mediacopier/file_register.hpp>
 #include <mediacopier/operation_copy_jpeg.hpp>
+#include <mediacopier/operation_link_jpeg.hpp>
 #include <mediacopier/operation_move_jpeg.hpp>
 #include <mediacopier/operation_simulate.hpp>
 
@@ -31,13 +32,12 @@ template <typename T>
 static auto execute_operation(const fs::path& srcPath, const fs::path& dstBaseDir) -> const fs::path
 {
     FileRegister destinationRegister { dstBaseDir, DEFAULT_PATTERN, false };
-    auto file = FileInfoFactory::createFromPath(srcPath);
-    if (file == nullptr) {
+    const auto file = to_file_info(srcPath);
+    if (!file.has_value()) {
         throw std::runtime_error("file not found: " + srcPath.string());
     }
-    const auto path = destinationRegister.add(file).value();
-    T operation { path };
-    file->accept(operation);
+    const auto path = destinationRegister.add(file_info_base(file.value())).value();
+    mediacopier::execute_operation<T>(path, file.value());
     return path;
 }
 
@@ -47,6 +47,7 @@ public:
     {
         m_dstBaseDir1 = workdir() / "tmp1";
         m_dstBaseDir2 = workdir() / "tmp2";
+        m_dstBaseDir3 = workdir() / "tmp3";
     }
     auto checkAllOperations(const std::string& srcName, const std::string& dstName, const std::string& timestamp,
         const FileInfoImageJpeg::Orientation& orientation, const FileInfoImageJpeg::Orientation& orientationFixed,
@@ -54,6 +55,7 @@ public:
     {
         fs::remove_all(m_dstBaseDir1);
         fs::remove_all(m_dstBaseDir2);
+        fs::remove_all(m_dstBaseDir3);
 
         fs::path srcPath, dstPath;
 
@@ -84,6 +86,18 @@ public:
         dstPath = execute_operation<FileOperationCopyJpeg>(srcPath, m_dstBaseDir2);
         checkFileInfoCustom(dstPath, orientationFixed, timestamp);
         ASSERT_TRUE(fs::exists(srcPath));
+
+        // link src -> dst3
+        srcPath = srcName;
+        dstPath = execute_operation<FileOperationLink>(srcPath, m_dstBaseDir3);
+        checkFileInfoCustom(dstPath, orientation, timestamp);
+        ASSERT_TRUE(fs::equivalent(srcPath, dstPath));
+        fs::remove_all(m_dstBaseDir3);
+
+        // link src -> dst3, jpeg aware, rotated files are written
+        dstPath = execute_operation<FileOperationLinkJpeg>(srcPath, m_dstBaseDir3);
+        checkFileInfoCustom(dstPath, orientationFixed, timestamp);
+        ASSERT_EQ(fs::equivalent(srcPath, dstPath), orientation == orientationFixed);
     }
     const auto& dstdir()
     {
@@ -93,6 +107,7 @@ public:
 private:
     fs::path m_dstBaseDir1;
     fs::path m_dstBaseDir2;
+    fs::path m_dstBaseDir3;
 };
 
 TEST_F(FileOperationTests, singleImageJpeg0ImageAllOperations)
@@ -20,6 +20,8 @@
 #include <mediacopier/file_register.hpp>
 #include <mediacopier/operation_copy_jpeg.hpp>
 
+#include <fstream>
+
 namespace fs = std::filesystem;
 
 namespace mediacopier::test {
@@ -104,4 +106,108 @@ TEST_F(FileRegisterTests, multipleAddDifferentSource)
     ASSERT_TRUE(path2.has_value());
 }
 
+TEST_F(FileRegisterTests, writtenDestinationIsCompared)
+{
+    const auto& write = [this](const std::string& name, const std::string& content) {
+        const auto path = workdir() / name;
+        std::ofstream output { path };
+        output << content;
+        return path;
+    };
+    const auto src1 = write("test1.mp4", "same");
+    const auto src2 = write("test2.mp4", "same");
+    const auto src3 = write("test3.mp4", "different");
+    const Timestamp timestamp { std::chrono::sys_days { std::chrono::year { 2019 } / 2 / 5 } };
+
+    fs::remove_all(dstdir());
+    FileRegister dst { dstdir(), DEFAULT_PATTERN, false };
+    const auto path = dst.add(FileInfoVideo { src1, timestamp });
+    ASSERT_TRUE(path.has_value());
+    // derived from the first name, %S renders fractional seconds depending on the clock
+    const auto suffixed = path->stem().string() + "_1.mp4";
+
+    // not written yet, compared with the registered source
+    ASSERT_FALSE(dst.add(FileInfoVideo { src2, timestamp }).has_value());
+
+    // moved, compared with the file at destination
+    fs::create_directories(path->parent_path());
+    fs::rename(src1, path.value());
+    ASSERT_FALSE(dst.add(FileInfoVideo { src2, timestamp }).has_value());
+    ASSERT_EQ(dst.add(FileInfoVideo { src3, timestamp })->filename(), suffixed);
+
+    // the destination directory is listed by a new register
+    FileRegister next { dstdir(), DEFAULT_PATTERN, false };
+    ASSERT_FALSE(next.add(FileInfoVideo { src2, timestamp }).has_value());
+    ASSERT_EQ(next.add(FileInfoVideo { src3, timestamp })->filename(), suffixed);
+}
+
+TEST_F(FileRegisterTests, pendingDestinationIsNotCompared)
+{
+    const auto& write = [this](const std::string& name, const std::string& content) {
+        const auto path = workdir() / name;
+        std::ofstream output { path };
+        output << content;
+        return path;
+    };
+    const auto src1 = write("test1.mp4", "full content");
+    const auto src2 = write("test2.mp4", "different");
+    const auto src3 = write("test3.mp4", "full content");
+    const Timestamp timestamp { std::chrono::sys_days { std::chrono::year { 2019 } / 2 / 5 } };
+    const Timestamp later { std::chrono::sys_days { std::chrono::year { 2019 } / 2 / 6 } };
+
+    fs::remove_all(dstdir());
+    {
+        FileRegister dst { dstdir(), DEFAULT_PATTERN, false };
+        const auto path = dst.add(FileInfoVideo { src1, timestamp });
+        ASSERT_TRUE(path.has_value());
+
+        // half written by a background copy, it must not be read yet
+        dst.setPending(path.value());
+        fs::create_directories(path->parent_path());
+        write(path->lexically_relative(workdir()).string(), "full");
+        ASSERT_TRUE(dst.add(FileInfoVideo { src2, timestamp }).has_value());
+
+        fs::copy_file(src1, path.value(), fs::copy_options::overwrite_existing);
+        dst.setFinished(path.value());
+        dst.store();
+    }
+
+    // the catalog holds the hash of the whole file
+    FileRegister next { dstdir(), DEFAULT_PATTERN, false };
+    ASSERT_FALSE(next.add(FileInfoVideo { src3, later }).has_value());
+}
+
+TEST_F(FileRegisterTests, storeListsDestinationsAgain)
+{
+    const auto& write = [this](const std::string& name, const std::string& content) {
+        const auto path = workdir() / name;
+        std::ofstream output { path };
+        output << content;
+        return path;
+    };
+    const auto src1 = write("test1.mp4", "first");
+    const auto src2 = write("test2.mp4", "second");
+    const Timestamp timestamp1 { std::chrono::sys_days { std::chrono::year { 2019 } / 2 / 5 } };
+    const Timestamp timestamp2 { std::chrono::sys_days { std::chrono::year { 2019 } / 2 / 5 } + std::chrono::hours { 1 } };
+
+    fs::remove_all(dstdir());
+    FileRegister dst { dstdir(), DEFAULT_PATTERN, false };
+    const auto path = dst.add(FileInfoVideo { src1, timestamp1 });
+    ASSERT_TRUE(path.has_value());
+    fs::create_directories(path->parent_path());
+    fs::copy_file(src1, path.value());
+    dst.store();
+
+    // written by someone else into the directory listed before
+    const auto other = FileRegister { dstdir(), DEFAULT_PATTERN, false }.add(FileInfoVideo { src2, timestamp2 });
+    ASSERT_TRUE(other.has_value());
+    write(other->lexically_relative(workdir()).string(), "other");
+
+    const auto next = dst.add(FileInfoVideo { src2, timestamp2 });
+    ASSERT_TRUE(next.has_value());
+    ASSERT_NE(next.value(), other.value());
+    // imported before the store, found through the content catalog
+    ASSERT_FALSE(dst.add(FileInfoVideo { write("test3.mp4", "first"), timestamp2 }).has_value());
+}
+
 } // namespace mediacopier::test
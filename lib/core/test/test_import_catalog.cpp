@@ -0,0 +1,58 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/import_catalog.hpp>
+
+namespace fs = std::filesystem;
+
+namespace mediacopier::test {
+
+class ImportCatalogTests : public CommonTestFixtures {
+public:
+    static auto entry(uint64_t inode, uintmax_t size) -> DirectoryWalker::Entry
+    {
+        return { "file.jpg", size, 1, inode, std::chrono::system_clock::time_point { std::chrono::seconds { 1000 } } };
+    }
+};
+
+TEST_F(ImportCatalogTests, storeAndLoad)
+{
+    {
+        ImportCatalog catalog { workdir() };
+        ASSERT_EQ(catalog.size(), 0);
+        catalog.record(entry(1, 10), ImportCatalog::Outcome::Imported, workdir() / "out.jpg");
+        catalog.record(entry(2, 10), ImportCatalog::Outcome::NotMedia);
+        catalog.record(entry(3, 10), ImportCatalog::Outcome::Error);
+        catalog.record(entry(0, 10), ImportCatalog::Outcome::Imported);
+        catalog.store();
+    }
+
+    ImportCatalog catalog { workdir() };
+    ASSERT_EQ(catalog.size(), 3);
+    ASSERT_TRUE(catalog.isUnchanged(entry(1, 10)));
+    ASSERT_TRUE(catalog.isUnchanged(entry(2, 10)));
+    ASSERT_EQ(catalog.find(entry(1, 10))->destination, (workdir() / "out.jpg").string());
+
+    // errors are retried, modified files are handled again
+    ASSERT_FALSE(catalog.isUnchanged(entry(3, 10)));
+    ASSERT_FALSE(catalog.isUnchanged(entry(1, 11)));
+    ASSERT_FALSE(catalog.isUnchanged(entry(4, 10)));
+    ASSERT_FALSE(catalog.isUnchanged(entry(0, 10)));
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,167 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/isobmff_reader.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace mediacopier::test {
+
+class BoxBuilder {
+public:
+    auto u8(uint8_t value) -> BoxBuilder&
+    {
+        m_data.push_back(value);
+        return *this;
+    }
+    auto u16(uint16_t value) -> BoxBuilder&
+    {
+        return u8(static_cast<uint8_t>(value >> 8)).u8(static_cast<uint8_t>(value));
+    }
+    auto u32(uint32_t value) -> BoxBuilder&
+    {
+        return u16(static_cast<uint16_t>(value >> 16)).u16(static_cast<uint16_t>(value));
+    }
+    auto bytes(std::string_view value) -> BoxBuilder&
+    {
+        m_data.insert(m_data.end(), value.begin(), value.end());
+        return *this;
+    }
+    auto append(const BoxBuilder& other) -> BoxBuilder&
+    {
+        m_data.insert(m_data.end(), other.m_data.begin(), other.m_data.end());
+        return *this;
+    }
+    auto box(std::string_view type, const BoxBuilder& payload) -> BoxBuilder&
+    {
+        return u32(static_cast<uint32_t>(payload.size() + 8)).bytes(type).append(payload);
+    }
+    auto size() const noexcept -> size_t { return m_data.size(); }
+    auto write(const std::filesystem::path& path) const -> void
+    {
+        std::ofstream output { path, std::ios_base::out | std::ios_base::binary };
+        output.write(reinterpret_cast<const char*>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+class IsobmffReaderTests : public CommonTestFixtures {
+protected:
+    static auto movie(bool withAppleMetadata) -> BoxBuilder
+    {
+        BoxBuilder moov;
+        // version 0, creation time 2019-02-05T12:10:32 in seconds since 1904
+        moov.box("mvhd", BoxBuilder {}.u32(0).u32(3632213432).u32(0).u32(1000).u32(0));
+        if (withAppleMetadata) {
+            const std::string_view key { "com.apple.quicktime.creationdate" };
+            const std::string_view value { "2019-02-05T13:10:32+0100" };
+            BoxBuilder keys;
+            keys.u32(0).u32(2);
+            keys.u32(8 + 4).bytes("mdtacom.");
+            keys.u32(static_cast<uint32_t>(8 + key.size())).bytes("mdta").bytes(key);
+            BoxBuilder item;
+            item.box("data", BoxBuilder {}.u32(1).u32(0).bytes(value));
+            BoxBuilder ilst;
+            ilst.box(std::string_view { "\0\0\0\2", 4 }, item);
+            BoxBuilder meta;
+            meta.box("hdlr", BoxBuilder {}.u32(0).u32(0).bytes("mdta").u32(0).u32(0).u32(0).u8(0));
+            meta.box("keys", keys).box("ilst", ilst);
+            moov.box("meta", meta);
+        }
+
+        BoxBuilder file;
+        file.box("ftyp", BoxBuilder {}.bytes("qt  ").u32(0).bytes("qt  "));
+        // 64 bit size, the content is never read
+        const uint64_t mdatSize = 16 + 8 * 1024 * 1024;
+        file.u32(1).bytes("mdat").u32(static_cast<uint32_t>(mdatSize >> 32)).u32(static_cast<uint32_t>(mdatSize));
+        file.bytes(std::string(mdatSize - 16, '\0'));
+        file.box("moov", moov);
+        return file;
+    }
+};
+
+TEST_F(IsobmffReaderTests, readsMovieCreationTime)
+{
+    const auto path = workdir() / "test.mov";
+
+    movie(false).write(path);
+    FileSource plain { path };
+    ASSERT_EQ(read_isobmff_creation_time(plain), "2019-02-05T12:10:32.000000Z");
+    ASSERT_LE(plain.bytesRead(), 4 * FileSource::BLOCK_SIZE);
+
+    movie(true).write(path);
+    FileSource apple { path };
+    ASSERT_EQ(read_isobmff_creation_time(apple), "2019-02-05T13:10:32+0100");
+
+    // truncated files can't be walked
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+    FileSource truncated { path };
+    ASSERT_FALSE(read_isobmff_creation_time(truncated).has_value());
+}
+
+TEST_F(IsobmffReaderTests, readsHeifExifItem)
+{
+    // minimal tiff structure with a single date time entry in IFD0
+    BoxBuilder tiff;
+    tiff.bytes("MM").u16(42).u32(8).u16(1);
+    tiff.u16(0x0132).u16(2).u32(20).u32(26).u32(0);
+    tiff.bytes(std::string_view { "2019:02:05 12:10:32", 20 });
+
+    BoxBuilder iinf;
+    iinf.u32(0).u16(2);
+    iinf.box("infe", BoxBuilder {}.u32(0x02000000).u16(1).u16(0).bytes("hvc1"));
+    iinf.box("infe", BoxBuilder {}.u32(0x02000000).u16(2).u16(0).bytes("Exif"));
+
+    BoxBuilder file;
+    file.box("ftyp", BoxBuilder {}.bytes("heic").u32(0).bytes("mif1heic"));
+    const size_t itemOffset = file.size() + 8;
+    file.box("mdat", BoxBuilder {}.u32(6).bytes(std::string_view { "Exif\0\0", 6 }).append(tiff));
+
+    // version 0, 4 byte offsets and lengths, no base offset
+    BoxBuilder iloc;
+    iloc.u32(0).u8(0x44).u8(0).u16(2);
+    iloc.u16(1).u16(0).u16(1).u32(0).u32(0);
+    iloc.u16(2).u16(0).u16(1).u32(static_cast<uint32_t>(itemOffset)).u32(static_cast<uint32_t>(4 + 6 + tiff.size()));
+
+    BoxBuilder meta;
+    meta.u32(0);
+    meta.box("hdlr", BoxBuilder {}.u32(0).u32(0).bytes("pict").u32(0).u32(0).u32(0).u8(0));
+    meta.box("iinf", iinf).box("iloc", iloc);
+    file.box("meta", meta);
+
+    const auto path = workdir() / "test.heic";
+    file.write(path);
+    FileSource source { path };
+    const auto tags = read_isobmff_exif_tags(source);
+    ASSERT_TRUE(tags.has_value());
+    ASSERT_EQ(tags->dateTime[2], "2019:02:05 12:10:32");
+    ASSERT_EQ(tags->dateTime[0].data(), nullptr);
+
+    // without exif item
+    BoxBuilder empty;
+    empty.box("ftyp", BoxBuilder {}.bytes("heic").u32(0).bytes("mif1heic"));
+    empty.write(path);
+    FileSource emptySource { path };
+    ASSERT_FALSE(read_isobmff_exif_tags(emptySource).has_value());
+}
+
+} // namespace mediacopier::test
@@ -0,0 +1,71 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/naming_pattern.hpp>
+#include <mediacopier/persistent_config.hpp>
+
+#include <format>
+#include <string>
+
+namespace mediacopier::test {
+
+using namespace std::chrono;
+
+class NamingPatternTests : public CommonTestFixtures {
+protected:
+    static auto render(const std::string& pattern, system_clock::time_point tp) -> std::string
+    {
+        std::string output { "prefix/" };
+        NamingPattern { pattern }.render(tp, output);
+        return output;
+    }
+};
+
+TEST_F(NamingPatternTests, rendersCompiledPattern)
+{
+    const system_clock::time_point tp1 = sys_days { year { 2019 } / 2 / 5 } + hours { 12 } + minutes { 10 } + seconds { 32 } + microseconds { 123456 };
+    const system_clock::time_point tp2 = sys_days { year { 2021 } / 1 / 3 } + hours { 7 };
+    const system_clock::time_point tp3 = sys_days { year { 1969 } / 7 / 20 } + hours { 20 } + minutes { 17 } + seconds { 40 };
+
+    ASSERT_TRUE(NamingPattern { DEFAULT_PATTERN }.compiled());
+    ASSERT_EQ(render(DEFAULT_PATTERN, tp1), "prefix/2019/05/IMG_20190205_121032.123456000");
+    ASSERT_EQ(render(DEFAULT_PATTERN, tp2), "prefix/2021/00/IMG_20210103_070000.000000000");
+    ASSERT_EQ(render(DEFAULT_PATTERN, tp3), "prefix/1969/28/IMG_19690720_201740.000000000");
+
+    const std::string pattern { "%Y/%m/%d/TEST_%Y%m%d_%H%M%S" };
+    ASSERT_TRUE(NamingPattern { pattern }.compiled());
+    ASSERT_EQ(render(pattern, tp1), "prefix/2019/02/05/TEST_20190205_121032.123456000");
+
+    ASSERT_TRUE(NamingPattern { "%y-%j-%U-%W %%" }.compiled());
+    ASSERT_EQ(render("%y-%j-%U-%W %%", tp2), "prefix/21-003-01-00 %");
+    ASSERT_EQ(render("%y-%j-%U-%W %%", tp3), "prefix/69-201-29-28 %");
+    // the text in front of the first specifier is no chrono spec
+    ASSERT_EQ(render("100%% %Y", tp1), "prefix/100%% 2019");
+}
+
+TEST_F(NamingPatternTests, fallsBackToFormat)
+{
+    const system_clock::time_point tp = sys_days { year { 2019 } / 2 / 5 } + hours { 12 };
+    ASSERT_FALSE(NamingPattern { "%F_%a" }.compiled());
+    ASSERT_EQ(render("%F_%a", tp), "prefix/2019-02-05_Tue");
+    ASSERT_FALSE(NamingPattern { "{{%Y}}" }.compiled());
+    ASSERT_EQ(render("{{%Y}}", tp), "prefix/{2019}");
+    ASSERT_THROW(render("no specifier", tp), std::format_error);
+}
+
+} // namespace mediacopier::test
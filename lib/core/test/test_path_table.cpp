@@ -0,0 +1,61 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/path_table.hpp>
+
+#include <string>
+
+namespace mediacopier::test {
+
+class PathTableTests : public CommonTestFixtures {
+};
+
+TEST_F(PathTableTests, internsPaths)
+{
+    PathTable table;
+    const auto first = table.intern("/media/2019/02/IMG_0001.jpg");
+    const auto second = table.intern("/media/2019/02/IMG_0002.jpg");
+    ASSERT_NE(first, second);
+    ASSERT_EQ(table.intern("/media/2019/02/IMG_0001.jpg"), first);
+    ASSERT_EQ(table.size(), 2);
+
+    ASSERT_EQ(table.path(second), fs::path { "/media/2019/02/IMG_0002.jpg" });
+    ASSERT_EQ(table.directory(second), "/media/2019/02");
+    ASSERT_EQ(table.filename(second), "IMG_0002.jpg");
+    ASSERT_EQ(table.directory(first).data(), table.directory(second).data());
+
+    ASSERT_EQ(table.find("/media/2019/02/IMG_0002.jpg"), second);
+    ASSERT_FALSE(table.find("/media/2019/02/IMG_0003.jpg").has_value());
+    ASSERT_FALSE(table.find("/media/2019/03/IMG_0001.jpg").has_value());
+}
+
+TEST_F(PathTableTests, keepsViewsValid)
+{
+    PathTable table;
+    const auto first = table.intern("/media/first.jpg");
+    const auto view = table.filename(first);
+    for (size_t i = 0; i < 10000; ++i) {
+        table.intern("/media/" + std::to_string(i) + "/" + std::string(64, 'x'));
+    }
+    table.intern("/media/" + std::string(100000, 'y'));
+    ASSERT_EQ(table.filename(first).data(), view.data());
+    ASSERT_EQ(table.filename(first), "first.jpg");
+    ASSERT_EQ(table.path(table.size() - 1).filename().string().size(), 100000);
+}
+
+} // namespace mediacopier::test
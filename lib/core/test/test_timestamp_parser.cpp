@@ -0,0 +1,73 @@
+/* Copyright (C) 2026 Patrick Ziegler <zipat@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "common_test_fixtures.hpp"
+
+#include <mediacopier/timestamp_parser.hpp>
+
+namespace mediacopier::test {
+
+using namespace std::chrono;
+
+static const auto EXPECTED = sys_days { 2019y / February / 5 } + 12h + 10min + 32s;
+
+class TimestampParserTests : public CommonTestFixtures {
+};
+
+TEST_F(TimestampParserTests, parsesExifLayout)
+{
+    ASSERT_EQ(parse_exif_timestamp("2019:02:05 12:10:32"), EXPECTED);
+    ASSERT_EQ(parse_exif_timestamp("2019:02:05 12:10:32", "123"), EXPECTED + 123ms);
+    ASSERT_EQ(parse_exif_timestamp("2019:02:05 12:10:32", "5  "), EXPECTED + 500ms);
+    ASSERT_EQ(parse_exif_timestamp("2019:02:05 12:10:32.25", "123"), EXPECTED + 250ms);
+
+    // left to std::chrono::parse
+    ASSERT_FALSE(parse_exif_timestamp("0000:00:00 00:00:00").has_value());
+    ASSERT_FALSE(parse_exif_timestamp("2019:02:30 12:10:32").has_value());
+    ASSERT_FALSE(parse_exif_timestamp("2019-02-05 12:10:32").has_value());
+    ASSERT_FALSE(parse_exif_timestamp("2019:02:05 12:10").has_value());
+    ASSERT_FALSE(parse_exif_timestamp("2019:02:05 12:10:32", "1a").has_value());
+
+    ASSERT_EQ(parse_utc_offset("+01:00"), 60min);
+    ASSERT_EQ(parse_utc_offset("-00:30"), -30min);
+    ASSERT_FALSE(parse_utc_offset("+0100").has_value());
+    ASSERT_FALSE(parse_utc_offset("01:00").has_value());
+}
+
+TEST_F(TimestampParserTests, parsesIsoLayout)
+{
+    const auto libav = parse_iso_timestamp("2019-02-05T12:10:32.000000Z");
+    ASSERT_TRUE(libav.has_value());
+    ASSERT_EQ(libav->local, EXPECTED);
+    ASSERT_EQ(libav->offset, 0min);
+
+    const auto apple = parse_iso_timestamp("2019-02-05T12:10:32+0100");
+    ASSERT_TRUE(apple.has_value());
+    ASSERT_EQ(apple->local, EXPECTED);
+    ASSERT_EQ(apple->offset, 60min);
+
+    const auto plain = parse_iso_timestamp("2019-02-05T12:10:32.5");
+    ASSERT_TRUE(plain.has_value());
+    ASSERT_EQ(plain->local, EXPECTED + 500ms);
+    ASSERT_FALSE(plain->offset.has_value());
+
+    ASSERT_EQ(parse_iso_timestamp("2019-02-05T12:10:32-05:30")->offset, -330min);
+    ASSERT_FALSE(parse_iso_timestamp("2019-02-05 12:10:32").has_value());
+    ASSERT_FALSE(parse_iso_timestamp("2019-02-05T12:10:32 UTC").has_value());
+    ASSERT_FALSE(parse_iso_timestamp("2019-13-05T12:10:32Z").has_value());
+}
+
+} // namespace mediacopier::test
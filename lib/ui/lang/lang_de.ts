@@ -64,7 +64,12 @@
         <translation>Verschieben</translation>
     </message>
     <message>
-        <location filename="../source/widgets/MediaCopierParamWidget.cpp" line="49"/>
+        <location filename="../source/widgets/MediaCopierParamWidget.cpp" line="48"/>
+        <source>Link</source>
+        <translation>Verknüpfen</translation>
+    </message>
+    <message>
+        <location filename="../source/widgets/MediaCopierParamWidget.cpp" line="50"/>
         <source>Simulate</source>
         <translation>Simulieren</translation>
     </message>
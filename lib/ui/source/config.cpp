@@ -21,6 +21,7 @@
 static const std::map<QString, Config::Command> commands = {
     { "copy", Config::Command::Copy },
     { "move", Config::Command::Move },
+    { "link", Config::Command::Link },
 #ifndef NDEBUG
     { "sim", Config::Command::Sim }
 #endif
@@ -33,7 +34,7 @@ Config::Config(const QApplication& app)
     parser.setApplicationDescription(
         app.applicationName() + ", Copyright (C) 2020-2026 Patrick Ziegler");
     parser.addPositionalArgument(
-        "CMD", "Available commands: copy (default), move", "[CMD");
+        "CMD", "Available commands: copy (default), move, link", "[CMD");
     parser.addPositionalArgument(
         "SRC", "Input directory", "[SRC");
     parser.addPositionalArgument(
@@ -25,6 +25,7 @@ public:
     enum class Command {
         Copy,
         Move,
+        Link,
 #ifndef NDEBUG
         Sim
 #endif
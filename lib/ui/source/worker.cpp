@@ -16,9 +16,13 @@
 
 #include "worker.hpp"
 
-#include <mediacopier/file_info_factory.hpp>
+#include <mediacopier/copy_engine.hpp>
+#include <mediacopier/directory_walker.hpp>
 #include <mediacopier/file_register.hpp>
+#include <mediacopier/header_prefetcher.hpp>
+#include <mediacopier/metadata_prober.hpp>
 #include <mediacopier/operation_copy_jpeg.hpp>
+#include <mediacopier/operation_link_jpeg.hpp>
 #include <mediacopier/operation_move_jpeg.hpp>
 #ifndef NDEBUG
 #include <mediacopier/operation_simulate.hpp>
@@ -30,7 +34,6 @@
 #include <atomic>
 #include <chrono>
 #include <csignal>
-#include <ranges>
 #include <thread>
 
 namespace fs = std::filesystem;
@@ -63,38 +66,7 @@ auto is_operation_cancelled()
     return false;
 }
 
-auto media_files(const fs::path& path)
-{
-    static auto convert = [](const fs::directory_entry& entry) -> mc::FileInfoPtr {
-        if (fs::is_regular_file(entry)) {
-            return mc::to_file_info_ptr(entry.path());
-        } else {
-            return nullptr;
-        }
-    };
-
-    return std::ranges::subrange(
-               fs::recursive_directory_iterator(path),
-               fs::recursive_directory_iterator())
-        | std::ranges::views::transform(convert);
-}
-
-auto directory_entries_count(const fs::path& path) -> size_t
-{
-    return std::ranges::distance(
-        std::ranges::subrange(
-            fs::recursive_directory_iterator(path),
-            fs::recursive_directory_iterator()));
-}
-
-template <typename Operation>
-auto execute(const fs::path& dest, mc::FileInfoPtr file) -> void
-{
-    Operation op(dest);
-    file->accept(op);
-}
-
-typedef void (*ExecFuncPtr)(const fs::path&, mc::FileInfoPtr);
+typedef void (*ExecFuncPtr)(fs::path, const mc::FileInfo&);
 
 } // namespace
 
@@ -149,53 +121,77 @@ void Worker::kill()
 void Worker::exec()
 {
     ExecFuncPtr execute = nullptr;
+    bool simulate = false;
     switch (m_config->getCommand()) {
     case Config::Command::Copy:
-        execute = &::execute<mc::FileOperationCopyJpeg>;
+        execute = &mc::execute_operation<mc::FileOperationCopyJpeg>;
         break;
     case Config::Command::Move:
-        execute = &::execute<mc::FileOperationMoveJpeg>;
+        execute = &mc::execute_operation<mc::FileOperationMoveJpeg>;
+        break;
+    case Config::Command::Link:
+        execute = &mc::execute_operation<mc::FileOperationLinkJpeg>;
         break;
 #ifndef NDEBUG
     case Config::Command::Sim:
-        execute = &::execute<mc::FileOperationSimulate>;
+        execute = &mc::execute_operation<mc::FileOperationSimulate>;
+        simulate = true;
         break;
 #endif
     }
 
-    spdlog::info("Checking input directory..");
-    const auto count = directory_entries_count(m_config->getInputDir());
-
     // register callback for graceful shutdown via CTRL-C
     std::signal(SIGINT, [](int) -> void {
         operationCancelled.store(true);
     });
 
     auto fileRegister = mc::FileRegister { m_config->getOutputDir(), m_config->getPattern(), m_config->useUtc() };
+    auto walker = mc::DirectoryWalker { m_config->getInputDir(), true };
+    auto prefetcher = mc::HeaderPrefetcher { walker };
+    auto prober = mc::MetadataProber { prefetcher };
     std::optional<fs::path> dest;
+    StatusProgress status {};
 
+    mc::copy_stats().reset();
     spdlog::info("Executing operation..");
-    size_t progress = 0;
-    for (auto file : media_files(m_config->getInputDir())) {
-        ++progress;
+    for (const auto& [entry, file, error] : prober) {
         if (is_operation_cancelled()) {
             spdlog::info("Operation was cancelled..");
             break;
         }
-        Q_EMIT updateProgress({ count, progress });
+        // the scan runs ahead of the processing, totals grow until it is complete
+        const auto scan = walker.progress();
+        status.count = scan.files;
+        status.bytes = scan.bytes;
+        status.complete = scan.complete;
+        ++status.progress;
+        status.bytesProgress += entry.size;
+        Q_EMIT updateProgress(status);
         try {
-            if (file != nullptr && (dest = fileRegister.add(file)).has_value()) {
-                spdlog::debug("Processing: {0} -> {1}", file->path().string(), dest.value().string());
-                Q_EMIT updateDescription({ file->path(), dest.value() });
-                execute(dest.value(), file);
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
+            if (file.has_value() && (dest = fileRegister.add(mc::file_info_base(file.value()))).has_value()) {
+                const auto& path = mc::file_info_base(file.value()).path();
+                spdlog::debug("Processing: {0} -> {1}", path.string(), dest.value().string());
+                Q_EMIT updateDescription({ path, dest.value() });
+                execute(dest.value(), file.value());
             }
         } catch (const std::exception& err) {
             spdlog::error(err.what());
         }
     }
 
+    status.complete = walker.progress().complete;
+    Q_EMIT updateProgress(status);
+
     spdlog::info("Removing duplicates in destination directory..");
     fileRegister.removeDuplicates();
+    if (!simulate) {
+        fileRegister.store();
+    }
+
+    mc::copy_stats().log();
 
     spdlog::info("Writing config..");
     m_config->writeConfigFile();
@@ -28,8 +28,11 @@ struct StatusDescription {
 };
 
 struct StatusProgress {
-    size_t count;
-    size_t progress;
+    size_t count = 0; // files found so far
+    size_t progress = 0;
+    uintmax_t bytes = 0; // bytes found so far
+    uintmax_t bytesProgress = 0;
+    bool complete = false; // true when count and bytes are final
 };
 
 class Worker : public QObject {